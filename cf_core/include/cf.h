@@ -34,14 +34,18 @@ extern "C" {
 //==============================================================================
 
 #if CF_RTOS_ENABLED
+    #include "os/cf_alloc.h"
     #include "os/cf_mutex.h"
     #include "os/cf_task.h"
     #include "os/cf_queue.h"
+    #include "os/cf_semaphore.h"
     #include "os/cf_timer.h"
     #include "os/cf_time.h"
     #include "os/cf_critical.h"
 #endif
 
+#include "os/cf_atomic.h"
+
 //==============================================================================
 // UTILITIES
 //==============================================================================
@@ -59,6 +63,13 @@ extern "C" {
 
 #if CF_THREADPOOL_ENABLED
     #include "threadpool/cf_threadpool.h"
+    #include "threadpool/cf_threadpool_future.h"
+    #include "threadpool/cf_threadpool_parallel.h"
+    #include "threadpool/cf_threadpool_graph.h"
+    #include "threadpool/cf_threadpool_timer.h"
+    #include "threadpool/cf_threadpool_strand.h"
+    #include "threadpool/cf_threadpool_co.h"
+    #include "threadpool/cf_threadpool_group.h"
 #endif
 
 #if CF_EVENT_ENABLED
@@ -62,6 +62,14 @@
     #define CF_RTOS_FREERTOS             1
 #endif
 
+#ifndef CF_STATIC_ALLOCATION
+    #define CF_STATIC_ALLOCATION         0
+#endif
+
+#ifndef CF_STATIC_ARENA_SIZE
+    #define CF_STATIC_ARENA_SIZE         32768
+#endif
+
 //==============================================================================
 // DEBUG CONFIGURATION
 //==============================================================================
@@ -122,6 +130,110 @@
     #define CF_THREADPOOL_STACK_SIZE     2048
 #endif
 
+#ifndef CF_THREADPOOL_WORK_STEALING
+    #define CF_THREADPOOL_WORK_STEALING  0
+#endif
+
+#ifndef CF_THREADPOOL_LOCAL_QUEUE_SIZE
+    #define CF_THREADPOOL_LOCAL_QUEUE_SIZE 8
+#endif
+
+#ifndef CF_THREADPOOL_SCALE_UP_THRESHOLD
+    #define CF_THREADPOOL_SCALE_UP_THRESHOLD 4
+#endif
+
+#ifndef CF_THREADPOOL_SCALE_UP_DELAY_MS
+    #define CF_THREADPOOL_SCALE_UP_DELAY_MS 50
+#endif
+
+#ifndef CF_THREADPOOL_IDLE_TIMEOUT_MS
+    #define CF_THREADPOOL_IDLE_TIMEOUT_MS 5000
+#endif
+
+#ifndef CF_THREADPOOL_LATENCY_STATS
+    #define CF_THREADPOOL_LATENCY_STATS  0
+#endif
+
+#ifndef CF_THREADPOOL_FUTURE_POOL_SIZE
+    #define CF_THREADPOOL_FUTURE_POOL_SIZE 16
+#endif
+
+#ifndef CF_THREADPOOL_PARALLEL_SLOTS
+    #define CF_THREADPOOL_PARALLEL_SLOTS 4
+#endif
+
+#ifndef CF_THREADPOOL_GRAPH_MAX_SUCCESSORS
+    #define CF_THREADPOOL_GRAPH_MAX_SUCCESSORS 4
+#endif
+
+#ifndef CF_THREADPOOL_TIMER_SLOTS
+    #define CF_THREADPOOL_TIMER_SLOTS    32
+#endif
+
+#ifndef CF_THREADPOOL_TIMER_TICK_MS
+    #define CF_THREADPOOL_TIMER_TICK_MS  10
+#endif
+
+#ifndef CF_THREADPOOL_SCHED_POLICY
+    #define CF_THREADPOOL_SCHED_POLICY   CF_THREADPOOL_SCHED_STRICT
+#endif
+
+#ifndef CF_THREADPOOL_AGING_STEP_MS
+    #define CF_THREADPOOL_AGING_STEP_MS  100
+#endif
+
+#ifndef CF_THREADPOOL_DEADLINE_QUEUE_SIZE
+    #define CF_THREADPOOL_DEADLINE_QUEUE_SIZE 0
+#endif
+
+#ifndef CF_THREADPOOL_DROP_LATE
+    #define CF_THREADPOOL_DROP_LATE      0
+#endif
+
+#ifndef CF_THREADPOOL_INLINE_ARG_SIZE
+    #define CF_THREADPOOL_INLINE_ARG_SIZE 0
+#endif
+
+#ifndef CF_THREADPOOL_OVERLOAD_POLICY
+    #define CF_THREADPOOL_OVERLOAD_POLICY CF_THREADPOOL_OVERLOAD_BLOCK
+#endif
+
+#ifndef CF_THREADPOOL_STRAND_BATCH
+    #define CF_THREADPOOL_STRAND_BATCH   8
+#endif
+
+#ifndef CF_THREADPOOL_SCRATCH_SIZE
+    #define CF_THREADPOOL_SCRATCH_SIZE   0
+#endif
+
+#ifndef CF_THREADPOOL_WORKER_LOCAL_SLOTS
+    #define CF_THREADPOOL_WORKER_LOCAL_SLOTS 4
+#endif
+
+#ifndef CF_THREADPOOL_TLS_INDEX
+    #define CF_THREADPOOL_TLS_INDEX      -1
+#endif
+
+#ifndef CF_THREADPOOL_CO_TICK_MS
+    #define CF_THREADPOOL_CO_TICK_MS     10
+#endif
+
+#ifndef CF_THREADPOOL_PRIORITY_INHERIT
+    #define CF_THREADPOOL_PRIORITY_INHERIT 0
+#endif
+
+#ifndef CF_THREADPOOL_UNIQUE_SLOTS
+    #define CF_THREADPOOL_UNIQUE_SLOTS   16
+#endif
+
+#ifndef CF_THREADPOOL_STACK_CALIBRATION
+    #define CF_THREADPOOL_STACK_CALIBRATION 0
+#endif
+
+#ifndef CF_THREADPOOL_STACK_PROFILE_SLOTS
+    #define CF_THREADPOOL_STACK_PROFILE_SLOTS 32
+#endif
+
 //==============================================================================
 // MEMORY POOL CONFIGURATION
 //==============================================================================
@@ -162,6 +274,10 @@
 // CONFIGURATION VALIDATION
 //==============================================================================
 
+#if CF_STATIC_ALLOCATION && CF_STATIC_ARENA_SIZE < 1024
+    #error "CF_STATIC_ARENA_SIZE too small (min 1024)"
+#endif
+
 #if CF_LOG_MAX_SINKS > 8
     #error "CF_LOG_MAX_SINKS too large (max 8)"
 #endif
@@ -178,6 +294,58 @@
     #error "CF_THREADPOOL_THREAD_COUNT too small (min 1)"
 #endif
 
+#if CF_THREADPOOL_LOCAL_QUEUE_SIZE < 1
+    #error "CF_THREADPOOL_LOCAL_QUEUE_SIZE too small (min 1)"
+#endif
+
+#if CF_THREADPOOL_FUTURE_POOL_SIZE < 1
+    #error "CF_THREADPOOL_FUTURE_POOL_SIZE too small (min 1)"
+#endif
+
+#if CF_THREADPOOL_PARALLEL_SLOTS < 1
+    #error "CF_THREADPOOL_PARALLEL_SLOTS too small (min 1)"
+#endif
+
+#if CF_THREADPOOL_GRAPH_MAX_SUCCESSORS < 1
+    #error "CF_THREADPOOL_GRAPH_MAX_SUCCESSORS too small (min 1)"
+#endif
+
+#if CF_THREADPOOL_TIMER_SLOTS < 1 || CF_THREADPOOL_TIMER_SLOTS > 65534
+    #error "CF_THREADPOOL_TIMER_SLOTS out of range (1-65534)"
+#endif
+
+#if CF_THREADPOOL_TIMER_TICK_MS < 1
+    #error "CF_THREADPOOL_TIMER_TICK_MS too small (min 1)"
+#endif
+
+#if CF_THREADPOOL_AGING_STEP_MS < 1
+    #error "CF_THREADPOOL_AGING_STEP_MS too small (min 1)"
+#endif
+
+#if CF_THREADPOOL_DEADLINE_QUEUE_SIZE < 0 || CF_THREADPOOL_DEADLINE_QUEUE_SIZE > 65535
+    #error "CF_THREADPOOL_DEADLINE_QUEUE_SIZE out of range (0-65535)"
+#endif
+
+#if CF_THREADPOOL_INLINE_ARG_SIZE < 0 || CF_THREADPOOL_INLINE_ARG_SIZE > 255
+    #error "CF_THREADPOOL_INLINE_ARG_SIZE out of range (0-255)"
+#endif
+
+#if CF_THREADPOOL_STRAND_BATCH < 1
+    #error "CF_THREADPOOL_STRAND_BATCH too small (min 1)"
+#endif
+
+#if CF_THREADPOOL_WORKER_LOCAL_SLOTS < 0 || CF_THREADPOOL_WORKER_LOCAL_SLOTS > 32
+    #error "CF_THREADPOOL_WORKER_LOCAL_SLOTS out of range (0-32)"
+#endif
+
+#if CF_THREADPOOL_CO_TICK_MS < 1
+    #error "CF_THREADPOOL_CO_TICK_MS too small (min 1)"
+#endif
+
+#if CF_THREADPOOL_STACK_CALIBRATION && CF_THREADPOOL_STACK_PROFILE_SLOTS < 1
+    #error "CF_THREADPOOL_STACK_PROFILE_SLOTS too small (min 1)"
+#endif
+
 #if CF_EVENT_MAX_SUBSCRIBERS > 64
     #error "CF_EVENT_MAX_SUBSCRIBERS too large (max 64)"
 #endif
@@ -52,6 +52,7 @@ typedef enum {
     CF_ERROR_NOT_INITIALIZED,       /**< Module not initialized */
     CF_ERROR_ALREADY_INITIALIZED,   /**< Module already initialized */
     CF_ERROR_NOT_FOUND,             /**< Item/resource not found */
+    CF_ERROR_CANCELLED,             /**< Operation cancelled before it ran */
 
     // Hardware errors (40-49)
     CF_ERROR_HARDWARE,              /**< Hardware error */
@@ -0,0 +1,85 @@
+/**
+ * @file cf_alloc.h
+ * @brief Framework memory allocation (FreeRTOS heap or static arena)
+ * @version 1.0.0
+ * @date 2025-11-20
+ * @author CFramework Contributors
+ *
+ * @copyright Copyright (c) 2025 CFramework
+ * Licensed under MIT License
+ *
+ * @description
+ * Every allocation made by the framework itself goes through cf_alloc().
+ * By default it forwards to pvPortMalloc(). With CF_STATIC_ALLOCATION it
+ * carves blocks from a single static arena of CF_STATIC_ARENA_SIZE bytes
+ * instead, and the OS wrappers create their kernel objects with the
+ * FreeRTOS *CreateStatic() functions on that memory. Heap usage is then
+ * fixed at link time and startup is deterministic.
+ *
+ * The arena never reclaims memory: cf_free() is a no-op, so objects are
+ * meant to be created once at boot. Repeatedly destroying and re-creating
+ * them eventually exhausts the arena (creation then fails with
+ * CF_ERROR_NO_MEMORY).
+ */
+
+#ifndef CF_ALLOC_H
+#define CF_ALLOC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cf_common.h"
+
+#if CF_RTOS_ENABLED
+
+//==============================================================================
+// CONSTANTS
+//==============================================================================
+
+/**
+ * @brief Alignment of blocks returned by cf_alloc() in static mode
+ */
+#define CF_ALLOC_ALIGN                  8
+
+//==============================================================================
+// PUBLIC API
+//==============================================================================
+
+/**
+ * @brief Allocate framework memory
+ *
+ * @param[in] size Number of bytes
+ *
+ * @return Pointer to the block, or NULL if out of memory (or size is 0)
+ *
+ * @note This function is thread-safe
+ */
+void* cf_alloc(size_t size);
+
+/**
+ * @brief Release memory from cf_alloc()
+ *
+ * @param[in] ptr Block to release (NULL is ignored)
+ *
+ * @note This function is thread-safe
+ * @note No-op with CF_STATIC_ALLOCATION
+ */
+void cf_free(void* ptr);
+
+/**
+ * @brief Get the number of arena bytes handed out so far
+ *
+ * @return Bytes used (0 without CF_STATIC_ALLOCATION)
+ *
+ * @note Useful to size CF_STATIC_ARENA_SIZE after boot
+ */
+size_t cf_alloc_arena_used(void);
+
+#endif /* CF_RTOS_ENABLED */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CF_ALLOC_H */
@@ -0,0 +1,274 @@
+/**
+ * @file cf_atomic.h
+ * @brief Lock-free 32-bit atomic counters
+ * @version 1.0.0
+ * @date 2025-11-20
+ * @author CFramework Contributors
+ *
+ * @copyright Copyright (c) 2025 CFramework
+ * Licensed under MIT License
+ *
+ * @description
+ * Minimal atomic operations for statistics counters and reference counts.
+ * All operations are sequentially consistent and safe from both task and
+ * ISR context. Backends:
+ * - C11 <stdatomic.h> on host builds and ESP32 (GCC __atomic builtins when
+ *   the header is included from C++)
+ * - LDREX/STREX on ARMv7-M (Cortex-M3/M4/M7)
+ * - FreeRTOS ISR-safe critical section everywhere else (e.g. Cortex-M0)
+ */
+
+#ifndef CF_ATOMIC_H
+#define CF_ATOMIC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cf_common.h"
+
+//==============================================================================
+// BACKEND SELECTION
+//==============================================================================
+
+#if defined(__arm__) && (defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)) && !defined(ESP_PLATFORM)
+    #define CF_ATOMIC_USE_LDREX     1
+#elif defined(__arm__) && !defined(ESP_PLATFORM)
+    #define CF_ATOMIC_USE_CRITICAL  1
+#elif !defined(__cplusplus) && defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && \
+      !defined(__STDC_NO_ATOMICS__)
+    #define CF_ATOMIC_USE_C11       1
+    #include <stdatomic.h>
+#else
+    #define CF_ATOMIC_USE_BUILTIN   1
+#endif
+
+#if defined(CF_ATOMIC_USE_CRITICAL) && CF_RTOS_ENABLED
+    #ifdef ESP_PLATFORM
+        #include "freertos/FreeRTOS.h"
+        #include "freertos/task.h"
+    #else
+        #include "FreeRTOS.h"
+        #include "task.h"
+    #endif
+#endif
+
+//==============================================================================
+// TYPE DEFINITIONS
+//==============================================================================
+
+/**
+ * @brief Atomic 32-bit unsigned counter
+ *
+ * Zero-initialised storage is a valid counter with value 0.
+ */
+#if defined(CF_ATOMIC_USE_C11)
+typedef _Atomic uint32_t cf_atomic_u32_t;
+#else
+typedef volatile uint32_t cf_atomic_u32_t;
+#endif
+
+//==============================================================================
+// PRIVATE HELPERS
+//==============================================================================
+
+#if defined(CF_ATOMIC_USE_LDREX)
+static inline uint32_t cf_atomic_ldrex_(volatile uint32_t* addr)
+{
+    uint32_t value;
+    __asm volatile ("ldrex %0, [%1]" : "=r" (value) : "r" (addr) : "memory");
+    return value;
+}
+
+static inline uint32_t cf_atomic_strex_(volatile uint32_t* addr, uint32_t value)
+{
+    uint32_t failed;
+    __asm volatile ("strex %0, %2, [%1]" : "=&r" (failed) : "r" (addr), "r" (value) : "memory");
+    return failed;
+}
+
+static inline void cf_atomic_dmb_(void)
+{
+    __asm volatile ("dmb" ::: "memory");
+}
+#endif
+
+#if defined(CF_ATOMIC_USE_CRITICAL)
+    #if CF_RTOS_ENABLED
+        #define CF_ATOMIC_ENTER_()  UBaseType_t cf_atomic_saved_ = taskENTER_CRITICAL_FROM_ISR()
+        #define CF_ATOMIC_EXIT_()   taskEXIT_CRITICAL_FROM_ISR(cf_atomic_saved_)
+    #else
+        #define CF_ATOMIC_ENTER_()  uint32_t cf_atomic_saved_; \
+                                    __asm volatile ("mrs %0, primask\n cpsid i" : "=r" (cf_atomic_saved_) :: "memory")
+        #define CF_ATOMIC_EXIT_()   __asm volatile ("msr primask, %0" :: "r" (cf_atomic_saved_) : "memory")
+    #endif
+#endif
+
+//==============================================================================
+// PUBLIC API
+//==============================================================================
+
+/**
+ * @brief Read a counter
+ *
+ * @param[in] atomic Counter
+ * @return Current value
+ *
+ * @note Task and ISR safe
+ */
+static inline uint32_t cf_atomic_load(cf_atomic_u32_t* atomic)
+{
+#if defined(CF_ATOMIC_USE_C11)
+    return atomic_load(atomic);
+#elif defined(CF_ATOMIC_USE_BUILTIN)
+    return __atomic_load_n(atomic, __ATOMIC_SEQ_CST);
+#else
+    /* Aligned 32-bit loads are single-copy atomic on Cortex-M */
+    uint32_t value = *atomic;
+    #if defined(CF_ATOMIC_USE_LDREX)
+        cf_atomic_dmb_();
+    #endif
+    return value;
+#endif
+}
+
+/**
+ * @brief Write a counter
+ *
+ * @param[in] atomic Counter
+ * @param[in] value New value
+ *
+ * @note Task and ISR safe
+ */
+static inline void cf_atomic_store(cf_atomic_u32_t* atomic, uint32_t value)
+{
+#if defined(CF_ATOMIC_USE_C11)
+    atomic_store(atomic, value);
+#elif defined(CF_ATOMIC_USE_BUILTIN)
+    __atomic_store_n(atomic, value, __ATOMIC_SEQ_CST);
+#else
+    #if defined(CF_ATOMIC_USE_LDREX)
+        cf_atomic_dmb_();
+    #endif
+    *atomic = value;
+    #if defined(CF_ATOMIC_USE_LDREX)
+        cf_atomic_dmb_();
+    #endif
+#endif
+}
+
+/**
+ * @brief Add to a counter
+ *
+ * @param[in] atomic Counter
+ * @param[in] value Amount to add
+ * @return Value before the addition
+ *
+ * @note Task and ISR safe
+ */
+static inline uint32_t cf_atomic_fetch_add(cf_atomic_u32_t* atomic, uint32_t value)
+{
+#if defined(CF_ATOMIC_USE_C11)
+    return atomic_fetch_add(atomic, value);
+#elif defined(CF_ATOMIC_USE_BUILTIN)
+    return __atomic_fetch_add(atomic, value, __ATOMIC_SEQ_CST);
+#elif defined(CF_ATOMIC_USE_LDREX)
+    uint32_t old;
+    cf_atomic_dmb_();
+    do {
+        old = cf_atomic_ldrex_(atomic);
+    } while (cf_atomic_strex_(atomic, old + value) != 0);
+    cf_atomic_dmb_();
+    return old;
+#else
+    CF_ATOMIC_ENTER_();
+    uint32_t old = *atomic;
+    *atomic = old + value;
+    CF_ATOMIC_EXIT_();
+    return old;
+#endif
+}
+
+/**
+ * @brief Subtract from a counter
+ *
+ * @param[in] atomic Counter
+ * @param[in] value Amount to subtract
+ * @return Value before the subtraction
+ *
+ * @note Task and ISR safe
+ */
+static inline uint32_t cf_atomic_fetch_sub(cf_atomic_u32_t* atomic, uint32_t value)
+{
+    return cf_atomic_fetch_add(atomic, (uint32_t)0 - value);
+}
+
+/**
+ * @brief Compare and swap
+ *
+ * Stores desired if the counter equals *expected; otherwise loads the
+ * current value into *expected.
+ *
+ * @param[in] atomic Counter
+ * @param[in,out] expected Expected value / current value on failure
+ * @param[in] desired Value to store
+ * @return true if the value was swapped
+ *
+ * @note Task and ISR safe
+ */
+static inline bool cf_atomic_compare_exchange(cf_atomic_u32_t* atomic, uint32_t* expected, uint32_t desired)
+{
+#if defined(CF_ATOMIC_USE_C11)
+    return atomic_compare_exchange_strong(atomic, expected, desired);
+#elif defined(CF_ATOMIC_USE_BUILTIN)
+    return __atomic_compare_exchange_n(atomic, expected, desired, false,
+                                       __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+#elif defined(CF_ATOMIC_USE_LDREX)
+    uint32_t current;
+    cf_atomic_dmb_();
+    do {
+        current = cf_atomic_ldrex_(atomic);
+        if (current != *expected) {
+            __asm volatile ("clrex" ::: "memory");
+            *expected = current;
+            return false;
+        }
+    } while (cf_atomic_strex_(atomic, desired) != 0);
+    cf_atomic_dmb_();
+    return true;
+#else
+    bool swapped = false;
+    CF_ATOMIC_ENTER_();
+    if (*atomic == *expected) {
+        *atomic = desired;
+        swapped = true;
+    } else {
+        *expected = *atomic;
+    }
+    CF_ATOMIC_EXIT_();
+    return swapped;
+#endif
+}
+
+/**
+ * @brief Raise a counter to at least value
+ *
+ * @param[in] atomic Counter
+ * @param[in] value Candidate maximum
+ *
+ * @note Task and ISR safe
+ */
+static inline void cf_atomic_store_max(cf_atomic_u32_t* atomic, uint32_t value)
+{
+    uint32_t current = cf_atomic_load(atomic);
+
+    while (current < value && !cf_atomic_compare_exchange(atomic, &current, value)) {
+        // current was refreshed by the failed exchange
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CF_ATOMIC_H */
@@ -40,6 +40,19 @@ extern "C" {
 static portMUX_TYPE cf_critical_mux = portMUX_INITIALIZER_UNLOCKED;
 #endif
 
+//==============================================================================
+// TYPE DEFINITIONS
+//==============================================================================
+
+/**
+ * @brief Interrupt state saved by cf_critical_section_enter_from_isr()
+ */
+#if CF_RTOS_ENABLED
+typedef UBaseType_t cf_critical_state_t;
+#else
+typedef uint32_t cf_critical_state_t;
+#endif
+
 //==============================================================================
 // PUBLIC API
 //==============================================================================
@@ -100,40 +113,51 @@ static inline void cf_critical_section_exit(void)
 /**
  * @brief Enter critical section from ISR context
  *
+ * @return Interrupt state to pass to cf_critical_section_exit_from_isr()
+ *
  * @note ISR-safe, can be called from interrupt handlers
  * @note Must be paired with cf_critical_section_exit_from_isr()
- *
- * @warning Some RTOS implementations don't support nested ISR critical sections
+ * @note On FreeRTOS: calls taskENTER_CRITICAL_FROM_ISR(), which saves the
+ *       interrupt mask instead of asserting outside task context
+ * @note On ESP32: calls portENTER_CRITICAL_ISR()
  */
-static inline void cf_critical_section_enter_from_isr(void)
+static inline cf_critical_state_t cf_critical_section_enter_from_isr(void)
 {
 #if CF_RTOS_ENABLED
     #ifdef ESP_PLATFORM
         portENTER_CRITICAL_ISR(&cf_critical_mux);
+        return 0;
     #else
-        /* FreeRTOS doesn't have separate ISR critical section API */
-        taskENTER_CRITICAL();
+        return taskENTER_CRITICAL_FROM_ISR();
     #endif
 #else
+    cf_critical_state_t state = __get_PRIMASK();
     __disable_irq();
+    return state;
 #endif
 }
 
 /**
  * @brief Exit critical section from ISR context
  *
+ * Restores the interrupt mask that was active before the matching enter,
+ * so nested interrupt levels are left as they were.
+ *
+ * @param[in] state Value returned by cf_critical_section_enter_from_isr()
+ *
  * @note Must be paired with cf_critical_section_enter_from_isr()
  */
-static inline void cf_critical_section_exit_from_isr(void)
+static inline void cf_critical_section_exit_from_isr(cf_critical_state_t state)
 {
 #if CF_RTOS_ENABLED
     #ifdef ESP_PLATFORM
+        (void)state;
         portEXIT_CRITICAL_ISR(&cf_critical_mux);
     #else
-        taskEXIT_CRITICAL();
+        taskEXIT_CRITICAL_FROM_ISR(state);
     #endif
 #else
-    __enable_irq();
+    __set_PRIMASK(state);
 #endif
 }
 
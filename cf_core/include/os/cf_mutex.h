@@ -18,6 +18,16 @@ extern "C" {
 
 #include "cf_common.h"
 
+#if CF_RTOS_ENABLED
+    #ifdef ESP_PLATFORM
+        #include "freertos/FreeRTOS.h"
+        #include "freertos/semphr.h"
+    #else
+        #include "FreeRTOS.h"
+        #include "semphr.h"
+    #endif
+#endif
+
 #if CF_RTOS_ENABLED
 
 //==============================================================================
@@ -29,6 +39,27 @@ extern "C" {
  */
 typedef struct cf_mutex_s* cf_mutex_t;
 
+/**
+ * @brief Mutex object
+ *
+ * Defined here only so that cf_mutex_static_t can be sized; the fields are
+ * private.
+ */
+struct cf_mutex_s {
+    SemaphoreHandle_t handle;
+    bool is_static;             /**< Storage owned by the caller */
+};
+
+#if configSUPPORT_STATIC_ALLOCATION
+/**
+ * @brief Caller-provided storage for cf_mutex_create_static()
+ */
+typedef struct {
+    struct cf_mutex_s mutex;
+    StaticSemaphore_t buffer;   /**< FreeRTOS control block */
+} cf_mutex_static_t;
+#endif
+
 //==============================================================================
 // PUBLIC API
 //==============================================================================
@@ -47,6 +78,25 @@ typedef struct cf_mutex_s* cf_mutex_t;
  */
 cf_status_t cf_mutex_create(cf_mutex_t* mutex);
 
+#if configSUPPORT_STATIC_ALLOCATION
+/**
+ * @brief Create a mutex in caller-provided storage
+ *
+ * No heap memory is used. The storage must stay valid until
+ * cf_mutex_destroy(), which does not free it.
+ *
+ * @param[out] mutex Pointer to receive mutex handle
+ * @param[in] storage Storage for the wrapper and the kernel object
+ *
+ * @return CF_OK on success
+ * @return CF_ERROR_NULL_POINTER if mutex or storage is NULL
+ * @return CF_ERROR_MUTEX if creation failed
+ *
+ * @note This function is thread-safe
+ */
+cf_status_t cf_mutex_create_static(cf_mutex_t* mutex, cf_mutex_static_t* storage);
+#endif
+
 /**
  * @brief Destroy a mutex
  *
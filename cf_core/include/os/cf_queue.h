@@ -18,6 +18,16 @@ extern "C" {
 
 #include "cf_common.h"
 
+#if CF_RTOS_ENABLED
+    #ifdef ESP_PLATFORM
+        #include "freertos/FreeRTOS.h"
+        #include "freertos/queue.h"
+    #else
+        #include "FreeRTOS.h"
+        #include "queue.h"
+    #endif
+#endif
+
 #if CF_RTOS_ENABLED
 
 //==============================================================================
@@ -29,6 +39,27 @@ extern "C" {
  */
 typedef struct cf_queue_s* cf_queue_t;
 
+/**
+ * @brief Queue object
+ *
+ * Defined here only so that cf_queue_static_t can be sized; the fields are
+ * private.
+ */
+struct cf_queue_s {
+    QueueHandle_t handle;
+    bool is_static;             /**< Storage owned by the caller */
+};
+
+#if configSUPPORT_STATIC_ALLOCATION
+/**
+ * @brief Caller-provided storage for cf_queue_create_static()
+ */
+typedef struct {
+    struct cf_queue_s queue;
+    StaticQueue_t buffer;       /**< FreeRTOS control block */
+} cf_queue_static_t;
+#endif
+
 //==============================================================================
 // PUBLIC API
 //==============================================================================
@@ -49,6 +80,33 @@ typedef struct cf_queue_s* cf_queue_t;
  */
 cf_status_t cf_queue_create(cf_queue_t* queue, uint32_t length, uint32_t item_size);
 
+#if configSUPPORT_STATIC_ALLOCATION
+/**
+ * @brief Create a queue in caller-provided storage
+ *
+ * No heap memory is used. Both buffers must stay valid until
+ * cf_queue_destroy(), which does not free them.
+ *
+ * @param[out] queue Pointer to receive queue handle
+ * @param[in] length Maximum number of items in queue
+ * @param[in] item_size Size of each item in bytes
+ * @param[in] buffer Item storage of at least length * item_size bytes
+ * @param[in] storage Storage for the wrapper and the kernel object
+ *
+ * @return CF_OK on success
+ * @return CF_ERROR_NULL_POINTER if queue, buffer or storage is NULL
+ * @return CF_ERROR_INVALID_PARAM if length or item_size is 0
+ * @return CF_ERROR_OS if creation failed
+ *
+ * @note This function is thread-safe
+ */
+cf_status_t cf_queue_create_static(cf_queue_t* queue,
+                                   uint32_t length,
+                                   uint32_t item_size,
+                                   uint8_t* buffer,
+                                   cf_queue_static_t* storage);
+#endif
+
 /**
  * @brief Destroy a queue
  *
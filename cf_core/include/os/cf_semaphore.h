@@ -0,0 +1,178 @@
+/**
+ * @file cf_semaphore.h
+ * @brief Counting semaphore wrapper for FreeRTOS
+ * @version 1.0.0
+ * @date 2025-11-20
+ * @author CFramework Contributors
+ *
+ * @copyright Copyright (c) 2025 CFramework
+ * Licensed under MIT License
+ */
+
+#ifndef CF_SEMAPHORE_H
+#define CF_SEMAPHORE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cf_common.h"
+
+#if CF_RTOS_ENABLED
+    #ifdef ESP_PLATFORM
+        #include "freertos/FreeRTOS.h"
+        #include "freertos/semphr.h"
+    #else
+        #include "FreeRTOS.h"
+        #include "semphr.h"
+    #endif
+#endif
+
+#if CF_RTOS_ENABLED
+
+//==============================================================================
+// TYPE DEFINITIONS
+//==============================================================================
+
+/**
+ * @brief Opaque semaphore handle
+ */
+typedef struct cf_semaphore_s* cf_semaphore_t;
+
+/**
+ * @brief Semaphore object
+ *
+ * Defined here only so that cf_semaphore_static_t can be sized; the fields
+ * are private.
+ */
+struct cf_semaphore_s {
+    SemaphoreHandle_t handle;
+    bool is_static;             /**< Storage owned by the caller */
+};
+
+#if configSUPPORT_STATIC_ALLOCATION
+/**
+ * @brief Caller-provided storage for cf_semaphore_create_static()
+ */
+typedef struct {
+    struct cf_semaphore_s sem;
+    StaticSemaphore_t buffer;   /**< FreeRTOS control block */
+} cf_semaphore_static_t;
+#endif
+
+//==============================================================================
+// PUBLIC API
+//==============================================================================
+
+/**
+ * @brief Create a counting semaphore
+ *
+ * @param[out] sem Pointer to receive semaphore handle
+ * @param[in] max_count Maximum count the semaphore can reach
+ * @param[in] initial_count Initial count
+ *
+ * @return CF_OK on success
+ * @return CF_ERROR_NULL_POINTER if sem is NULL
+ * @return CF_ERROR_INVALID_PARAM if max_count is 0 or initial_count > max_count
+ * @return CF_ERROR_NO_MEMORY if creation failed
+ *
+ * @note This function is thread-safe
+ * @note Created semaphore must be destroyed with cf_semaphore_destroy()
+ */
+cf_status_t cf_semaphore_create(cf_semaphore_t* sem, uint32_t max_count, uint32_t initial_count);
+
+#if configSUPPORT_STATIC_ALLOCATION
+/**
+ * @brief Create a counting semaphore in caller-provided storage
+ *
+ * No heap memory is used. The storage must stay valid until
+ * cf_semaphore_destroy(), which does not free it.
+ *
+ * @param[out] sem Pointer to receive semaphore handle
+ * @param[in] max_count Maximum count the semaphore can reach
+ * @param[in] initial_count Initial count
+ * @param[in] storage Storage for the wrapper and the kernel object
+ *
+ * @return CF_OK on success
+ * @return CF_ERROR_NULL_POINTER if sem or storage is NULL
+ * @return CF_ERROR_INVALID_PARAM if max_count is 0 or initial_count > max_count
+ * @return CF_ERROR_SEMAPHORE if creation failed
+ *
+ * @note This function is thread-safe
+ */
+cf_status_t cf_semaphore_create_static(cf_semaphore_t* sem,
+                                       uint32_t max_count,
+                                       uint32_t initial_count,
+                                       cf_semaphore_static_t* storage);
+#endif
+
+/**
+ * @brief Destroy a semaphore
+ *
+ * @param[in] sem Semaphore handle to destroy
+ *
+ * @note This function is thread-safe
+ * @warning Do not destroy a semaphore a task is blocked on
+ */
+void cf_semaphore_destroy(cf_semaphore_t sem);
+
+/**
+ * @brief Take (decrement) a semaphore
+ *
+ * @param[in] sem Semaphore handle
+ * @param[in] timeout_ms Timeout in milliseconds (CF_WAIT_FOREVER for infinite)
+ *
+ * @return CF_OK on success
+ * @return CF_ERROR_NULL_POINTER if sem is NULL
+ * @return CF_ERROR_TIMEOUT if timeout occurred
+ *
+ * @note This function is thread-safe
+ */
+cf_status_t cf_semaphore_take(cf_semaphore_t sem, uint32_t timeout_ms);
+
+/**
+ * @brief Give (increment) a semaphore
+ *
+ * @param[in] sem Semaphore handle
+ *
+ * @return CF_OK on success
+ * @return CF_ERROR_NULL_POINTER if sem is NULL
+ * @return CF_ERROR_SEMAPHORE if the semaphore is already at max_count
+ *
+ * @note This function is thread-safe
+ */
+cf_status_t cf_semaphore_give(cf_semaphore_t sem);
+
+/**
+ * @brief Give (increment) a semaphore from ISR context
+ *
+ * @param[in] sem Semaphore handle
+ * @param[out] pxHigherPriorityTaskWoken Set to pdTRUE if context switch needed (optional)
+ *
+ * @return CF_OK on success
+ * @return CF_ERROR_NULL_POINTER if sem is NULL
+ * @return CF_ERROR_SEMAPHORE if the semaphore is already at max_count
+ *
+ * @note This function is ISR-safe (FreeRTOS FromISR variant)
+ * @note Caller must call portYIELD_FROM_ISR() if pxHigherPriorityTaskWoken is set
+ */
+cf_status_t cf_semaphore_give_from_isr(cf_semaphore_t sem, BaseType_t* pxHigherPriorityTaskWoken);
+
+/**
+ * @brief Get current semaphore count
+ *
+ * @param[in] sem Semaphore handle
+ *
+ * @return Current count (0 if sem is NULL)
+ *
+ * @note This function is thread-safe
+ */
+uint32_t cf_semaphore_get_count(cf_semaphore_t sem);
+
+#endif /* CF_RTOS_ENABLED */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CF_SEMAPHORE_H */
@@ -18,6 +18,16 @@ extern "C" {
 
 #include "cf_common.h"
 
+#if CF_RTOS_ENABLED
+    #ifdef ESP_PLATFORM
+        #include "freertos/FreeRTOS.h"
+        #include "freertos/task.h"
+    #else
+        #include "FreeRTOS.h"
+        #include "task.h"
+    #endif
+#endif
+
 #if CF_RTOS_ENABLED
 
 //==============================================================================
@@ -29,6 +39,27 @@ extern "C" {
  */
 typedef struct cf_task_s* cf_task_t;
 
+/**
+ * @brief Task object
+ *
+ * Defined here only so that cf_task_static_t can be sized; the fields are
+ * private.
+ */
+struct cf_task_s {
+    TaskHandle_t handle;
+    bool is_static;             /**< Storage owned by the caller */
+};
+
+#if configSUPPORT_STATIC_ALLOCATION
+/**
+ * @brief Caller-provided storage for cf_task_create_static()
+ */
+typedef struct {
+    struct cf_task_s task;
+    StaticTask_t buffer;        /**< FreeRTOS task control block */
+} cf_task_static_t;
+#endif
+
 /**
  * @brief Task function type
  */
@@ -77,12 +108,39 @@ typedef struct {
  */
 cf_status_t cf_task_create(cf_task_t* task, const cf_task_config_t* config);
 
+#if configSUPPORT_STATIC_ALLOCATION
+/**
+ * @brief Create and start a task in caller-provided storage
+ *
+ * No heap memory is used. The stack and storage must stay valid until the
+ * task has been deleted; cf_task_delete() does not free them.
+ *
+ * @param[out] task Pointer to receive task handle
+ * @param[in] config Task configuration
+ * @param[in] stack Stack of config->stack_size bytes
+ * @param[in] storage Storage for the wrapper and the task control block
+ *
+ * @return CF_OK on success
+ * @return CF_ERROR_NULL_POINTER if task, config, stack or storage is NULL
+ * @return CF_ERROR_INVALID_PARAM if config->stack_size is 0
+ * @return CF_ERROR_OS if creation failed
+ *
+ * @note This function is thread-safe
+ */
+cf_status_t cf_task_create_static(cf_task_t* task,
+                                  const cf_task_config_t* config,
+                                  StackType_t* stack,
+                                  cf_task_static_t* storage);
+#endif
+
 /**
  * @brief Delete a task
  *
  * @param[in] task Task handle (NULL for current task)
  *
  * @note This function is thread-safe
+ * @note A task may pass its own handle to delete itself; the handle is
+ *       released before the task stops running
  * @warning If task is NULL, the calling task will be deleted
  */
 void cf_task_delete(cf_task_t task);
@@ -116,6 +174,36 @@ cf_task_t cf_task_get_current(void);
  */
 const char* cf_task_get_name(cf_task_t task);
 
+/**
+ * @brief Change task priority
+ *
+ * @param[in] task Task handle (NULL for current task)
+ * @param[in] priority New priority
+ *
+ * @return CF_OK on success
+ * @return CF_ERROR_INVALID_PARAM if priority is out of range
+ * @return CF_ERROR_INVALID_STATE if task has no FreeRTOS task
+ *
+ * @note This function is thread-safe
+ */
+cf_status_t cf_task_set_priority(cf_task_t task, cf_task_priority_t priority);
+
+/**
+ * @brief Get the stack high-water mark of a task
+ *
+ * Reports how close the task has come to overflowing its stack, which is
+ * what a stack size has to be tuned against.
+ *
+ * @param[in] task Task handle (NULL for current task)
+ *
+ * @return Least free stack space since the task started, in bytes
+ * @return 0 if task has no FreeRTOS task
+ *
+ * @note Requires INCLUDE_uxTaskGetStackHighWaterMark in FreeRTOSConfig.h
+ * @note This function is thread-safe
+ */
+uint32_t cf_task_get_stack_high_water_mark(cf_task_t task);
+
 /**
  * @brief Start the RTOS scheduler
  *
@@ -155,6 +155,115 @@ static inline bool cf_time_is_timeout(uint32_t start_tick, uint32_t timeout_ms)
     return cf_time_elapsed_ms(start_tick) >= timeout_ms;
 }
 
+//==============================================================================
+// CYCLE COUNTER
+//==============================================================================
+
+#if CF_RTOS_ENABLED && defined(ESP_PLATFORM)
+    #include "esp_cpu.h"
+    #include "esp_idf_version.h"
+    #define CF_TIME_HAS_CYCLE_COUNTER   1
+#elif CF_RTOS_ENABLED && (defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__))
+    /* Cortex-M3/M4/M7 DWT cycle counter */
+    #define CF_TIME_HAS_CYCLE_COUNTER   1
+    #define CF_TIME_DEMCR               (*(volatile uint32_t*)0xE000EDFCUL)
+    #define CF_TIME_DEMCR_TRCENA        (1UL << 24)
+    #define CF_TIME_DWT_CTRL            (*(volatile uint32_t*)0xE0001000UL)
+    #define CF_TIME_DWT_CTRL_CYCCNTENA  (1UL << 0)
+    #define CF_TIME_DWT_CYCCNT          (*(volatile uint32_t*)0xE0001004UL)
+#else
+    /* No cycle counter: fall back to the RTOS tick */
+    #define CF_TIME_HAS_CYCLE_COUNTER   0
+#endif
+
+/**
+ * @brief Enable the cycle counter
+ *
+ * @note Needed once on Cortex-M (turns on DWT CYCCNT); no-op elsewhere
+ * @note Safe to call several times
+ */
+static inline void cf_time_cycle_counter_init(void)
+{
+#if CF_TIME_HAS_CYCLE_COUNTER && !defined(ESP_PLATFORM)
+    if ((CF_TIME_DWT_CTRL & CF_TIME_DWT_CTRL_CYCCNTENA) == 0) {
+        CF_TIME_DEMCR |= CF_TIME_DEMCR_TRCENA;
+        CF_TIME_DWT_CYCCNT = 0;
+        CF_TIME_DWT_CTRL |= CF_TIME_DWT_CTRL_CYCCNTENA;
+    }
+#endif
+}
+
+/**
+ * @brief Get high-resolution timestamp
+ *
+ * @return CPU cycle count, or tick count on ports without a cycle counter
+ *
+ * @note Thread-safe, can be called from task context
+ * @note The counter is 32 bits wide and wraps (after ~26 s at 160 MHz);
+ *       differences are correct as long as the interval is shorter
+ */
+static inline uint32_t cf_time_get_cycle_count(void)
+{
+#if CF_TIME_HAS_CYCLE_COUNTER && defined(ESP_PLATFORM)
+    #if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+        return (uint32_t)esp_cpu_get_cycle_count();
+    #else
+        return (uint32_t)esp_cpu_get_ccount();
+    #endif
+#elif CF_TIME_HAS_CYCLE_COUNTER
+    return CF_TIME_DWT_CYCCNT;
+#else
+    return cf_time_get_tick_count();
+#endif
+}
+
+/**
+ * @brief Get high-resolution timestamp from ISR context
+ *
+ * @return CPU cycle count, or tick count on ports without a cycle counter
+ *
+ * @note ISR-safe, can be called from interrupt handlers
+ */
+static inline uint32_t cf_time_get_cycle_count_from_isr(void)
+{
+#if CF_TIME_HAS_CYCLE_COUNTER
+    return cf_time_get_cycle_count();
+#else
+    return cf_time_get_tick_count_from_isr();
+#endif
+}
+
+/**
+ * @brief Get frequency of cf_time_get_cycle_count()
+ *
+ * @return Counter frequency in Hz (CPU clock, or tick rate as fallback)
+ */
+static inline uint32_t cf_time_get_cycle_frequency(void)
+{
+#if CF_TIME_HAS_CYCLE_COUNTER
+    return (uint32_t)configCPU_CLOCK_HZ;
+#else
+    return (uint32_t)configTICK_RATE_HZ;
+#endif
+}
+
+/**
+ * @brief Convert a cycle count difference to microseconds
+ *
+ * @param[in] cycles Difference of two cf_time_get_cycle_count() values
+ * @return Equivalent time in microseconds
+ */
+static inline uint32_t cf_time_cycles_to_us(uint32_t cycles)
+{
+    uint32_t freq = cf_time_get_cycle_frequency();
+
+    if (freq >= 1000000UL) {
+        return cycles / (freq / 1000000UL);
+    }
+
+    return cycles * (1000000UL / freq);
+}
+
 #ifdef __cplusplus
 }
 #endif
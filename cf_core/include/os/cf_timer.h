@@ -64,6 +64,28 @@ typedef struct {
     bool auto_start;                 /**< Start timer immediately after creation */
 } cf_timer_config_t;
 
+/**
+ * @brief Timer context (stored as the FreeRTOS timer ID)
+ *
+ * Defined here only so that cf_timer_static_t can be sized; the fields are
+ * private.
+ */
+typedef struct {
+    cf_timer_callback_t user_callback;
+    void* user_arg;
+    bool is_static;                  /**< Storage owned by the caller */
+} cf_timer_context_t;
+
+#if configSUPPORT_STATIC_ALLOCATION
+/**
+ * @brief Caller-provided storage for cf_timer_create_static()
+ */
+typedef struct {
+    cf_timer_context_t context;
+    StaticTimer_t buffer;            /**< FreeRTOS timer control block */
+} cf_timer_static_t;
+#endif
+
 //==============================================================================
 // PUBLIC API
 //==============================================================================
@@ -83,6 +105,29 @@ typedef struct {
  */
 cf_status_t cf_timer_create(cf_timer_t* handle, const cf_timer_config_t* config);
 
+#if configSUPPORT_STATIC_ALLOCATION
+/**
+ * @brief Create software timer in caller-provided storage
+ *
+ * No heap memory is used. The storage must stay valid until the timer has
+ * been deleted; cf_timer_delete() does not free it.
+ *
+ * @param[out] handle Pointer to receive timer handle
+ * @param[in] config Timer configuration
+ * @param[in] storage Storage for the context and the timer control block
+ *
+ * @return CF_OK on success
+ * @return CF_ERROR_NULL_POINTER if parameters are NULL
+ * @return CF_ERROR_INVALID_PARAM if config is invalid
+ * @return CF_ERROR_OS if creation failed
+ *
+ * @note This function is thread-safe
+ */
+cf_status_t cf_timer_create_static(cf_timer_t* handle,
+                                   const cf_timer_config_t* config,
+                                   cf_timer_static_t* storage);
+#endif
+
 /**
  * @brief Delete timer
  *
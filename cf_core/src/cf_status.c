@@ -32,6 +32,7 @@ const char* cf_status_to_string(cf_status_t status)
         case CF_ERROR_NOT_INITIALIZED:      return "CF_ERROR_NOT_INITIALIZED";
         case CF_ERROR_ALREADY_INITIALIZED:  return "CF_ERROR_ALREADY_INITIALIZED";
         case CF_ERROR_NOT_FOUND:            return "CF_ERROR_NOT_FOUND";
+        case CF_ERROR_CANCELLED:            return "CF_ERROR_CANCELLED";
 
         case CF_ERROR_HARDWARE:             return "CF_ERROR_HARDWARE";
         case CF_ERROR_HAL:                  return "CF_ERROR_HAL";
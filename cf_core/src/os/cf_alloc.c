@@ -0,0 +1,88 @@
+/**
+ * @file cf_alloc.c
+ * @brief Framework memory allocation implementation
+ */
+
+#include "os/cf_alloc.h"
+
+#if CF_RTOS_ENABLED
+
+#include "os/cf_critical.h"
+
+#ifdef ESP_PLATFORM
+    #include "freertos/FreeRTOS.h"
+#else
+    #include "FreeRTOS.h"
+#endif
+
+#if CF_STATIC_ALLOCATION && !configSUPPORT_STATIC_ALLOCATION
+    #error "CF_STATIC_ALLOCATION requires configSUPPORT_STATIC_ALLOCATION"
+#endif
+
+//==============================================================================
+// PRIVATE VARIABLES
+//==============================================================================
+
+#if CF_STATIC_ALLOCATION
+/** Static arena; the union forces CF_ALLOC_ALIGN */
+static union {
+    uint8_t bytes[CF_STATIC_ARENA_SIZE];
+    uint64_t align_u64;
+    void* align_ptr;
+} g_arena;
+
+/** Bytes handed out, guarded by the critical section */
+static size_t g_arena_used = 0;
+#endif
+
+//==============================================================================
+// PUBLIC API IMPLEMENTATION
+//==============================================================================
+
+void* cf_alloc(size_t size)
+{
+    if (size == 0) {
+        return NULL;
+    }
+
+#if CF_STATIC_ALLOCATION
+    void* block = NULL;
+
+    cf_critical_section_enter();
+    // g_arena_used stays a multiple of CF_ALLOC_ALIGN
+    if (size <= sizeof(g_arena.bytes) - g_arena_used) {
+        block = &g_arena.bytes[g_arena_used];
+        g_arena_used += CF_ALIGN_UP(size, CF_ALLOC_ALIGN);
+        if (g_arena_used > sizeof(g_arena.bytes)) {
+            g_arena_used = sizeof(g_arena.bytes);
+        }
+    }
+    cf_critical_section_exit();
+
+    return block;
+#else
+    return pvPortMalloc(size);
+#endif
+}
+
+void cf_free(void* ptr)
+{
+#if CF_STATIC_ALLOCATION
+    (void)ptr;
+#else
+    if (ptr != NULL) {
+        vPortFree(ptr);
+    }
+#endif
+}
+
+size_t cf_alloc_arena_used(void)
+{
+#if CF_STATIC_ALLOCATION
+    return g_arena_used;
+#else
+    return 0;
+#endif
+}
+
+#endif /* CF_RTOS_ENABLED */
@@ -8,21 +8,7 @@
 #if CF_RTOS_ENABLED
 
 #include "cf_assert.h"
-#ifdef ESP_PLATFORM
-    #include "freertos/FreeRTOS.h"
-    #include "freertos/semphr.h"
-#else
-    #include "FreeRTOS.h"
-    #include "semphr.h"
-#endif
-
-//==============================================================================
-// TYPE DEFINITIONS
-//==============================================================================
-
-struct cf_mutex_s {
-    SemaphoreHandle_t handle;
-};
+#include "os/cf_alloc.h"
 
 //==============================================================================
 // PUBLIC API IMPLEMENTATION
@@ -32,8 +18,17 @@ cf_status_t cf_mutex_create(cf_mutex_t* mutex)
 {
     CF_PTR_CHECK(mutex);
 
+#if CF_STATIC_ALLOCATION
+    // Wrapper and control block from the static arena
+    cf_mutex_static_t* storage = (cf_mutex_static_t*)cf_alloc(sizeof(cf_mutex_static_t));
+    if (storage == NULL) {
+        return CF_ERROR_NO_MEMORY;
+    }
+
+    return cf_mutex_create_static(mutex, storage);
+#else
     // Allocate mutex structure
-    struct cf_mutex_s* mtx = (struct cf_mutex_s*)pvPortMalloc(sizeof(struct cf_mutex_s));
+    struct cf_mutex_s* mtx = (struct cf_mutex_s*)cf_alloc(sizeof(struct cf_mutex_s));
     if (mtx == NULL) {
         return CF_ERROR_NO_MEMORY;
     }
@@ -41,14 +36,33 @@ cf_status_t cf_mutex_create(cf_mutex_t* mutex)
     // Create FreeRTOS mutex
     mtx->handle = xSemaphoreCreateMutex();
     if (mtx->handle == NULL) {
-        vPortFree(mtx);
+        cf_free(mtx);
         return CF_ERROR_NO_MEMORY;
     }
+    mtx->is_static = false;
 
     *mutex = mtx;
     return CF_OK;
+#endif
 }
 
+#if configSUPPORT_STATIC_ALLOCATION
+cf_status_t cf_mutex_create_static(cf_mutex_t* mutex, cf_mutex_static_t* storage)
+{
+    CF_PTR_CHECK(mutex);
+    CF_PTR_CHECK(storage);
+
+    storage->mutex.handle = xSemaphoreCreateMutexStatic(&storage->buffer);
+    if (storage->mutex.handle == NULL) {
+        return CF_ERROR_MUTEX;
+    }
+    storage->mutex.is_static = true;
+
+    *mutex = &storage->mutex;
+    return CF_OK;
+}
+#endif
+
 void cf_mutex_destroy(cf_mutex_t mutex)
 {
     if (mutex == NULL) {
@@ -59,7 +73,9 @@ void cf_mutex_destroy(cf_mutex_t mutex)
         vSemaphoreDelete(mutex->handle);
     }
 
-    vPortFree(mutex);
+    if (!mutex->is_static) {
+        cf_free(mutex);
+    }
 }
 
 cf_status_t cf_mutex_lock(cf_mutex_t mutex, uint32_t timeout_ms)
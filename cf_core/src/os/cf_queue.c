@@ -8,21 +8,7 @@
 #if CF_RTOS_ENABLED
 
 #include "cf_assert.h"
-#ifdef ESP_PLATFORM
-    #include "freertos/FreeRTOS.h"
-    #include "freertos/queue.h"
-#else
-    #include "FreeRTOS.h"
-    #include "queue.h"
-#endif
-
-//==============================================================================
-// TYPE DEFINITIONS
-//==============================================================================
-
-struct cf_queue_s {
-    QueueHandle_t handle;
-};
+#include "os/cf_alloc.h"
 
 //==============================================================================
 // PUBLIC API IMPLEMENTATION
@@ -36,8 +22,18 @@ cf_status_t cf_queue_create(cf_queue_t* queue, uint32_t length, uint32_t item_si
         return CF_ERROR_INVALID_PARAM;
     }
 
+#if CF_STATIC_ALLOCATION
+    // Wrapper, control block and item storage from the static arena
+    cf_queue_static_t* storage = (cf_queue_static_t*)cf_alloc(sizeof(cf_queue_static_t));
+    uint8_t* buffer = (uint8_t*)cf_alloc((size_t)length * item_size);
+    if (storage == NULL || buffer == NULL) {
+        return CF_ERROR_NO_MEMORY;
+    }
+
+    return cf_queue_create_static(queue, length, item_size, buffer, storage);
+#else
     // Allocate queue structure
-    struct cf_queue_s* q = (struct cf_queue_s*)pvPortMalloc(sizeof(struct cf_queue_s));
+    struct cf_queue_s* q = (struct cf_queue_s*)cf_alloc(sizeof(struct cf_queue_s));
     if (q == NULL) {
         return CF_ERROR_NO_MEMORY;
     }
@@ -45,14 +41,42 @@ cf_status_t cf_queue_create(cf_queue_t* queue, uint32_t length, uint32_t item_si
     // Create FreeRTOS queue
     q->handle = xQueueCreate(length, item_size);
     if (q->handle == NULL) {
-        vPortFree(q);
+        cf_free(q);
         return CF_ERROR_NO_MEMORY;
     }
+    q->is_static = false;
 
     *queue = q;
     return CF_OK;
+#endif
 }
 
+#if configSUPPORT_STATIC_ALLOCATION
+cf_status_t cf_queue_create_static(cf_queue_t* queue,
+                                   uint32_t length,
+                                   uint32_t item_size,
+                                   uint8_t* buffer,
+                                   cf_queue_static_t* storage)
+{
+    CF_PTR_CHECK(queue);
+    CF_PTR_CHECK(buffer);
+    CF_PTR_CHECK(storage);
+
+    if (length == 0 || item_size == 0) {
+        return CF_ERROR_INVALID_PARAM;
+    }
+
+    storage->queue.handle = xQueueCreateStatic(length, item_size, buffer, &storage->buffer);
+    if (storage->queue.handle == NULL) {
+        return CF_ERROR_OS;
+    }
+    storage->queue.is_static = true;
+
+    *queue = &storage->queue;
+    return CF_OK;
+}
+#endif
+
 void cf_queue_destroy(cf_queue_t queue)
 {
     if (queue == NULL) {
@@ -63,7 +87,9 @@ void cf_queue_destroy(cf_queue_t queue)
         vQueueDelete(queue->handle);
     }
 
-    vPortFree(queue);
+    if (!queue->is_static) {
+        cf_free(queue);
+    }
 }
 
 cf_status_t cf_queue_send(cf_queue_t queue, const void* item, uint32_t timeout_ms)
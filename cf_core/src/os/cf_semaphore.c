@@ -0,0 +1,150 @@
+/**
+ * @file cf_semaphore.c
+ * @brief Counting semaphore wrapper implementation for FreeRTOS
+ */
+
+#include "os/cf_semaphore.h"
+
+#if CF_RTOS_ENABLED
+
+#include "cf_assert.h"
+#include "os/cf_alloc.h"
+
+//==============================================================================
+// PUBLIC API IMPLEMENTATION
+//==============================================================================
+
+cf_status_t cf_semaphore_create(cf_semaphore_t* sem, uint32_t max_count, uint32_t initial_count)
+{
+    CF_PTR_CHECK(sem);
+
+    if (max_count == 0 || initial_count > max_count) {
+        return CF_ERROR_INVALID_PARAM;
+    }
+
+#if CF_STATIC_ALLOCATION
+    // Wrapper and control block from the static arena
+    cf_semaphore_static_t* storage = (cf_semaphore_static_t*)cf_alloc(sizeof(cf_semaphore_static_t));
+    if (storage == NULL) {
+        return CF_ERROR_NO_MEMORY;
+    }
+
+    return cf_semaphore_create_static(sem, max_count, initial_count, storage);
+#else
+    // Allocate semaphore structure
+    struct cf_semaphore_s* s = (struct cf_semaphore_s*)cf_alloc(sizeof(struct cf_semaphore_s));
+    if (s == NULL) {
+        return CF_ERROR_NO_MEMORY;
+    }
+
+    // Create FreeRTOS counting semaphore
+    s->handle = xSemaphoreCreateCounting(max_count, initial_count);
+    if (s->handle == NULL) {
+        cf_free(s);
+        return CF_ERROR_NO_MEMORY;
+    }
+    s->is_static = false;
+
+    *sem = s;
+    return CF_OK;
+#endif
+}
+
+#if configSUPPORT_STATIC_ALLOCATION
+cf_status_t cf_semaphore_create_static(cf_semaphore_t* sem,
+                                       uint32_t max_count,
+                                       uint32_t initial_count,
+                                       cf_semaphore_static_t* storage)
+{
+    CF_PTR_CHECK(sem);
+    CF_PTR_CHECK(storage);
+
+    if (max_count == 0 || initial_count > max_count) {
+        return CF_ERROR_INVALID_PARAM;
+    }
+
+    storage->sem.handle = xSemaphoreCreateCountingStatic(max_count, initial_count, &storage->buffer);
+    if (storage->sem.handle == NULL) {
+        return CF_ERROR_SEMAPHORE;
+    }
+    storage->sem.is_static = true;
+
+    *sem = &storage->sem;
+    return CF_OK;
+}
+#endif
+
+void cf_semaphore_destroy(cf_semaphore_t sem)
+{
+    if (sem == NULL) {
+        return;
+    }
+
+    if (sem->handle != NULL) {
+        vSemaphoreDelete(sem->handle);
+    }
+
+    if (!sem->is_static) {
+        cf_free(sem);
+    }
+}
+
+cf_status_t cf_semaphore_take(cf_semaphore_t sem, uint32_t timeout_ms)
+{
+    CF_PTR_CHECK(sem);
+    CF_PTR_CHECK(sem->handle);
+
+    TickType_t ticks = (timeout_ms == CF_WAIT_FOREVER) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+
+    BaseType_t result = xSemaphoreTake(sem->handle, ticks);
+
+    if (result == pdTRUE) {
+        return CF_OK;
+    }
+
+    return CF_ERROR_TIMEOUT;
+}
+
+cf_status_t cf_semaphore_give(cf_semaphore_t sem)
+{
+    CF_PTR_CHECK(sem);
+    CF_PTR_CHECK(sem->handle);
+
+    BaseType_t result = xSemaphoreGive(sem->handle);
+
+    if (result == pdTRUE) {
+        return CF_OK;
+    }
+
+    return CF_ERROR_SEMAPHORE;
+}
+
+cf_status_t cf_semaphore_give_from_isr(cf_semaphore_t sem, BaseType_t* pxHigherPriorityTaskWoken)
+{
+    CF_PTR_CHECK(sem);
+    CF_PTR_CHECK(sem->handle);
+
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    BaseType_t result = xSemaphoreGiveFromISR(sem->handle, &xHigherPriorityTaskWoken);
+
+    if (pxHigherPriorityTaskWoken != NULL) {
+        *pxHigherPriorityTaskWoken = xHigherPriorityTaskWoken;
+    }
+
+    if (result == pdTRUE) {
+        return CF_OK;
+    }
+
+    return CF_ERROR_SEMAPHORE;
+}
+
+uint32_t cf_semaphore_get_count(cf_semaphore_t sem)
+{
+    if (sem == NULL || sem->handle == NULL) {
+        return 0;
+    }
+
+    return (uint32_t)uxSemaphoreGetCount(sem->handle);
+}
+
+#endif /* CF_RTOS_ENABLED */
@@ -8,13 +8,7 @@
 #if CF_RTOS_ENABLED
 
 #include "cf_assert.h"
-#ifdef ESP_PLATFORM
-    #include "freertos/FreeRTOS.h"
-    #include "freertos/task.h"
-#else
-    #include "FreeRTOS.h"
-    #include "task.h"
-#endif
+#include "os/cf_alloc.h"
 #include <string.h>
 
 //==============================================================================
@@ -24,14 +18,6 @@
 #define CF_TASK_DEFAULT_STACK_SIZE  512
 #define CF_TASK_DEFAULT_NAME        "cf_task"
 
-//==============================================================================
-// TYPE DEFINITIONS
-//==============================================================================
-
-struct cf_task_s {
-    TaskHandle_t handle;
-};
-
 //==============================================================================
 // PRIVATE FUNCTIONS
 //==============================================================================
@@ -60,8 +46,23 @@ cf_status_t cf_task_create(cf_task_t* task, const cf_task_config_t* config)
     CF_PTR_CHECK(config);
     CF_PTR_CHECK(config->function);
 
+#if CF_STATIC_ALLOCATION
+    // Wrapper, control block and stack from the static arena
+    cf_task_config_t cfg = *config;
+    if (cfg.stack_size == 0) {
+        cfg.stack_size = CF_TASK_DEFAULT_STACK_SIZE;
+    }
+
+    cf_task_static_t* storage = (cf_task_static_t*)cf_alloc(sizeof(cf_task_static_t));
+    StackType_t* stack = (StackType_t*)cf_alloc(cfg.stack_size);
+    if (storage == NULL || stack == NULL) {
+        return CF_ERROR_NO_MEMORY;
+    }
+
+    return cf_task_create_static(task, &cfg, stack, storage);
+#else
     // Allocate task structure
-    struct cf_task_s* tsk = (struct cf_task_s*)pvPortMalloc(sizeof(struct cf_task_s));
+    struct cf_task_s* tsk = (struct cf_task_s*)cf_alloc(sizeof(struct cf_task_s));
     if (tsk == NULL) {
         return CF_ERROR_NO_MEMORY;
     }
@@ -82,14 +83,54 @@ cf_status_t cf_task_create(cf_task_t* task, const cf_task_config_t* config)
     );
 
     if (result != pdPASS) {
-        vPortFree(tsk);
+        cf_free(tsk);
         return CF_ERROR_NO_MEMORY;
     }
+    tsk->is_static = false;
 
     *task = tsk;
     return CF_OK;
+#endif
 }
 
+#if configSUPPORT_STATIC_ALLOCATION
+cf_status_t cf_task_create_static(cf_task_t* task,
+                                  const cf_task_config_t* config,
+                                  StackType_t* stack,
+                                  cf_task_static_t* storage)
+{
+    CF_PTR_CHECK(task);
+    CF_PTR_CHECK(config);
+    CF_PTR_CHECK(config->function);
+    CF_PTR_CHECK(stack);
+    CF_PTR_CHECK(storage);
+
+    if (config->stack_size == 0) {
+        return CF_ERROR_INVALID_PARAM;
+    }
+
+    const char* name = config->name ? config->name : CF_TASK_DEFAULT_NAME;
+
+    storage->task.handle = xTaskCreateStatic(
+        (TaskFunction_t)config->function,
+        name,
+        config->stack_size / sizeof(StackType_t),  // Stack size in words
+        config->argument,
+        priority_to_freertos(config->priority),
+        stack,
+        &storage->buffer
+    );
+
+    if (storage->task.handle == NULL) {
+        return CF_ERROR_OS;
+    }
+    storage->task.is_static = true;
+
+    *task = &storage->task;
+    return CF_OK;
+}
+#endif
+
 void cf_task_delete(cf_task_t task)
 {
     if (task == NULL) {
@@ -98,11 +139,16 @@ void cf_task_delete(cf_task_t task)
         return;
     }
 
-    if (task->handle != NULL) {
-        vTaskDelete(task->handle);
+    TaskHandle_t handle = task->handle;
+    if (!task->is_static) {
+        cf_free(task);
     }
 
-    vPortFree(task);
+    // vTaskDelete() does not return when a task deletes itself, so the
+    // wrapper has to be released first
+    if (handle != NULL) {
+        vTaskDelete(handle);
+    }
 }
 
 void cf_task_delay(uint32_t delay_ms)
@@ -116,6 +162,7 @@ cf_task_t cf_task_get_current(void)
     // For full implementation, we'd need a handle registry
     static struct cf_task_s current_task;
     current_task.handle = xTaskGetCurrentTaskHandle();
+    current_task.is_static = true;
     return &current_task;
 }
 
@@ -132,6 +179,36 @@ const char* cf_task_get_name(cf_task_t task)
     return pcTaskGetName(task->handle);
 }
 
+cf_status_t cf_task_set_priority(cf_task_t task, cf_task_priority_t priority)
+{
+    if ((uint32_t)priority > CF_TASK_PRIORITY_REALTIME) {
+        return CF_ERROR_INVALID_PARAM;
+    }
+
+    TaskHandle_t handle = NULL;
+    if (task != NULL) {
+        if (task->handle == NULL) {
+            return CF_ERROR_INVALID_STATE;
+        }
+        handle = task->handle;
+    }
+
+    vTaskPrioritySet(handle, priority_to_freertos(priority));
+
+    return CF_OK;
+}
+
+uint32_t cf_task_get_stack_high_water_mark(cf_task_t task)
+{
+    if (task != NULL && task->handle == NULL) {
+        return 0;
+    }
+
+    TaskHandle_t handle = (task != NULL) ? task->handle : NULL;
+
+    return (uint32_t)uxTaskGetStackHighWaterMark(handle) * sizeof(StackType_t);
+}
+
 void cf_task_start_scheduler(void)
 {
     vTaskStartScheduler();
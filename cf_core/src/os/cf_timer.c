@@ -8,20 +8,9 @@
 #if CF_RTOS_ENABLED
 
 #include "cf_assert.h"
+#include "os/cf_alloc.h"
 #include <string.h>
 
-//==============================================================================
-// PRIVATE TYPES
-//==============================================================================
-
-/**
- * @brief Timer context (for callback wrapper)
- */
-typedef struct {
-    cf_timer_callback_t user_callback;
-    void* user_arg;
-} cf_timer_context_t;
-
 //==============================================================================
 // PRIVATE FUNCTIONS
 //==============================================================================
@@ -38,6 +27,44 @@ static void timer_callback_wrapper(TimerHandle_t xTimer)
     }
 }
 
+/**
+ * @brief Convert a timer period to ticks (minimum 1 tick)
+ */
+static TickType_t period_to_ticks(uint32_t period_ms)
+{
+    TickType_t period_ticks = pdMS_TO_TICKS(period_ms);
+    if (period_ticks == 0) {
+        period_ticks = 1;
+    }
+
+    return period_ticks;
+}
+
+/**
+ * @brief Publish a freshly created timer and auto-start it if requested
+ */
+static cf_status_t timer_finish_create(cf_timer_t* handle,
+                                       TimerHandle_t timer,
+                                       cf_timer_context_t* ctx,
+                                       const cf_timer_config_t* config)
+{
+    *handle = (cf_timer_t)timer;
+
+    // Auto-start if requested
+    if (config->auto_start) {
+        BaseType_t result = xTimerStart(timer, 0);
+        if (result != pdPASS) {
+            xTimerDelete(timer, 0);
+            if (!ctx->is_static) {
+                cf_free(ctx);
+            }
+            return CF_ERROR;
+        }
+    }
+
+    return CF_OK;
+}
+
 //==============================================================================
 // PUBLIC API IMPLEMENTATION
 //==============================================================================
@@ -52,49 +79,78 @@ cf_status_t cf_timer_create(cf_timer_t* handle, const cf_timer_config_t* config)
         return CF_ERROR_INVALID_PARAM;
     }
 
+#if CF_STATIC_ALLOCATION
+    // Context and control block from the static arena
+    cf_timer_static_t* storage = (cf_timer_static_t*)cf_alloc(sizeof(cf_timer_static_t));
+    if (storage == NULL) {
+        return CF_ERROR_NO_MEMORY;
+    }
+
+    return cf_timer_create_static(handle, config, storage);
+#else
     // Allocate context for callback
-    cf_timer_context_t* ctx = (cf_timer_context_t*)pvPortMalloc(sizeof(cf_timer_context_t));
+    cf_timer_context_t* ctx = (cf_timer_context_t*)cf_alloc(sizeof(cf_timer_context_t));
     if (ctx == NULL) {
         return CF_ERROR_NO_MEMORY;
     }
 
     ctx->user_callback = config->callback;
     ctx->user_arg = config->argument;
-
-    // Convert period to ticks
-    TickType_t period_ticks = pdMS_TO_TICKS(config->period_ms);
-    if (period_ticks == 0) {
-        period_ticks = 1;  // Minimum 1 tick
-    }
+    ctx->is_static = false;
 
     // Create timer
     TimerHandle_t timer = xTimerCreate(
         config->name ? config->name : "cf_timer",
-        period_ticks,
+        period_to_ticks(config->period_ms),
         config->type,
         ctx,  // Timer ID = context pointer
         timer_callback_wrapper
     );
 
     if (timer == NULL) {
-        vPortFree(ctx);
+        cf_free(ctx);
         return CF_ERROR_NO_MEMORY;
     }
 
-    *handle = (cf_timer_t)timer;
+    return timer_finish_create(handle, timer, ctx, config);
+#endif
+}
 
-    // Auto-start if requested
-    if (config->auto_start) {
-        BaseType_t result = xTimerStart(timer, 0);
-        if (result != pdPASS) {
-            xTimerDelete(timer, 0);
-            vPortFree(ctx);
-            return CF_ERROR;
-        }
+#if configSUPPORT_STATIC_ALLOCATION
+cf_status_t cf_timer_create_static(cf_timer_t* handle,
+                                   const cf_timer_config_t* config,
+                                   cf_timer_static_t* storage)
+{
+    CF_PTR_CHECK(handle);
+    CF_PTR_CHECK(config);
+    CF_PTR_CHECK(config->callback);
+    CF_PTR_CHECK(storage);
+
+    if (config->period_ms == 0) {
+        return CF_ERROR_INVALID_PARAM;
     }
 
-    return CF_OK;
+    cf_timer_context_t* ctx = &storage->context;
+    ctx->user_callback = config->callback;
+    ctx->user_arg = config->argument;
+    ctx->is_static = true;
+
+    TimerHandle_t timer = xTimerCreateStatic(
+        config->name ? config->name : "cf_timer",
+        period_to_ticks(config->period_ms),
+        config->type,
+        ctx,  // Timer ID = context pointer
+        timer_callback_wrapper,
+        &storage->buffer
+    );
+
+    if (timer == NULL) {
+        return CF_ERROR_OS;
+    }
+
+    return timer_finish_create(handle, timer, ctx, config);
 }
+#endif
 
 cf_status_t cf_timer_delete(cf_timer_t handle, uint32_t timeout_ms)
 {
@@ -104,8 +160,8 @@ cf_status_t cf_timer_delete(cf_timer_t handle, uint32_t timeout_ms)
 
     // Get context and free it
     cf_timer_context_t* ctx = (cf_timer_context_t*)pvTimerGetTimerID(timer);
-    if (ctx != NULL) {
-        vPortFree(ctx);
+    if (ctx != NULL && !ctx->is_static) {
+        cf_free(ctx);
     }
 
     // Delete timer
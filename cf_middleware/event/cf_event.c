@@ -8,6 +8,8 @@
 #if CF_EVENT_ENABLED && CF_RTOS_ENABLED
 
 #include "cf_assert.h"
+#include "os/cf_alloc.h"
+#include "os/cf_atomic.h"
 #include "os/cf_mutex.h"
 #include "threadpool/cf_threadpool.h"
 
@@ -24,6 +26,7 @@
 #else
     #include "FreeRTOS.h"
 #endif
+#include <stddef.h>
 #include <string.h>
 
 //==============================================================================
@@ -52,6 +55,21 @@ typedef struct {
     size_t data_size;
 } cf_event_dispatch_ctx_t;
 
+#if CF_THREADPOOL_INLINE_ARG_SIZE > 0
+/**
+ * @brief Event dispatch context carried inside the job (small payloads)
+ *
+ * Only the header and data_size bytes of data are submitted.
+ */
+typedef struct {
+    cf_event_callback_t callback;
+    void* user_data;
+    cf_event_id_t event_id;
+    uint8_t data_size;
+    uint8_t data[CF_THREADPOOL_INLINE_ARG_SIZE];
+} cf_event_inline_ctx_t;
+#endif
+
 /**
  * @brief Event system structure
  */
@@ -60,7 +78,7 @@ typedef struct {
     cf_mutex_t mutex;
     cf_event_subscriber_s subscribers[CF_EVENT_MAX_SUBSCRIBERS];
     uint32_t subscriber_count;
-    uint32_t total_published;
+    cf_atomic_u32_t total_published;
 } cf_event_system_t;
 
 //==============================================================================
@@ -93,6 +111,23 @@ static int32_t find_free_subscriber_slot(void)
     return -1;
 }
 
+/**
+ * @brief Heap allocation for per-event buffers
+ *
+ * Returns NULL with CF_STATIC_ALLOCATION: the static arena never reclaims
+ * memory, so per-event buffers must come from the pools or travel inline
+ * in the job.
+ */
+static void* event_heap_alloc(size_t size)
+{
+#if CF_STATIC_ALLOCATION
+    (void)size;
+    return NULL;
+#else
+    return cf_alloc(size);
+#endif
+}
+
 #if CF_MEMPOOL_ENABLED
 /**
  * @brief Initialize event system memory pools
@@ -172,8 +207,8 @@ static void* event_smart_alloc(size_t size)
         // Pool allocation failed - continue to heap fallback
     }
 
-    // Heap fallback (original behavior)
-    ptr = pvPortMalloc(size);
+    // Heap fallback
+    ptr = event_heap_alloc(size);
 
 #if CF_LOG_ENABLED
     if (ptr && g_event_pools_initialized) {
@@ -203,8 +238,8 @@ static void event_smart_free(void* ptr)
         // Not a pool pointer - continue to heap free
     }
 
-    // Heap free (original behavior)
-    vPortFree(ptr);
+    // Heap free
+    cf_free(ptr);
 }
 #endif /* CF_MEMPOOL_ENABLED */
 
@@ -229,7 +264,7 @@ static void event_dispatch_task(void* arg)
 #if CF_MEMPOOL_ENABLED
         event_smart_free(ctx->data);
 #else
-        vPortFree(ctx->data);
+        cf_free(ctx->data);
 #endif
     }
 
@@ -237,10 +272,23 @@ static void event_dispatch_task(void* arg)
 #if CF_MEMPOOL_ENABLED
     event_smart_free(ctx);
 #else
-    vPortFree(ctx);
+    cf_free(ctx);
 #endif
 }
 
+#if CF_THREADPOOL_INLINE_ARG_SIZE > 0
+/**
+ * @brief Async event dispatch task (context stored in the job itself)
+ */
+static void event_dispatch_inline_task(void* arg)
+{
+    const cf_event_inline_ctx_t* ctx = (const cf_event_inline_ctx_t*)arg;
+
+    ctx->callback(ctx->event_id, (ctx->data_size > 0) ? ctx->data : NULL,
+                  ctx->data_size, ctx->user_data);
+}
+#endif
+
 /**
  * @brief Deliver event to single subscriber
  */
@@ -254,10 +302,39 @@ static void deliver_to_subscriber(const cf_event_subscriber_s* sub,
         sub->callback(event_id, data, data_size, sub->user_data);
     } else {
         // Asynchronous - dispatch to ThreadPool
+#if CF_THREADPOOL_INLINE_ARG_SIZE > 0
+        // Small payloads travel inside the job: no allocation, no free
+        size_t inline_size = offsetof(cf_event_inline_ctx_t, data) + data_size;
+        if ((data != NULL || data_size == 0) && inline_size <= CF_THREADPOOL_INLINE_ARG_SIZE) {
+            cf_event_inline_ctx_t ictx;
+
+            ictx.callback = sub->callback;
+            ictx.user_data = sub->user_data;
+            ictx.event_id = event_id;
+            ictx.data_size = (uint8_t)data_size;
+            if (data_size > 0) {
+                memcpy(ictx.data, data, data_size);
+            }
+
+            cf_status_t status = cf_threadpool_submit_copy(event_dispatch_inline_task, &ictx,
+                                                           inline_size,
+                                                           CF_THREADPOOL_PRIORITY_NORMAL,
+                                                           100);
+#if CF_LOG_ENABLED
+            if (status != CF_OK) {
+                CF_LOG_E("Failed to submit async event: %d", status);
+            }
+#else
+            (void)status;
+#endif
+            return;
+        }
+#endif
+
 #if CF_MEMPOOL_ENABLED
         cf_event_dispatch_ctx_t* ctx = (cf_event_dispatch_ctx_t*)event_smart_alloc(sizeof(cf_event_dispatch_ctx_t));
 #else
-        cf_event_dispatch_ctx_t* ctx = (cf_event_dispatch_ctx_t*)pvPortMalloc(sizeof(cf_event_dispatch_ctx_t));
+        cf_event_dispatch_ctx_t* ctx = (cf_event_dispatch_ctx_t*)event_heap_alloc(sizeof(cf_event_dispatch_ctx_t));
 #endif
         if (ctx == NULL) {
 #if CF_LOG_ENABLED
@@ -276,7 +353,7 @@ static void deliver_to_subscriber(const cf_event_subscriber_s* sub,
 #if CF_MEMPOOL_ENABLED
             ctx->data = event_smart_alloc(data_size);
 #else
-            ctx->data = pvPortMalloc(data_size);
+            ctx->data = event_heap_alloc(data_size);
 #endif
             if (ctx->data == NULL) {
 #if CF_LOG_ENABLED
@@ -285,7 +362,7 @@ static void deliver_to_subscriber(const cf_event_subscriber_s* sub,
 #if CF_MEMPOOL_ENABLED
                 event_smart_free(ctx);
 #else
-                vPortFree(ctx);
+                cf_free(ctx);
 #endif
                 return;
             }
@@ -306,8 +383,8 @@ static void deliver_to_subscriber(const cf_event_subscriber_s* sub,
             if (ctx->data) event_smart_free(ctx->data);
             event_smart_free(ctx);
 #else
-            if (ctx->data) vPortFree(ctx->data);
-            vPortFree(ctx);
+            if (ctx->data) cf_free(ctx->data);
+            cf_free(ctx);
 #endif
         }
     }
@@ -332,7 +409,7 @@ cf_status_t cf_event_init(void)
     // Clear subscriber array
     memset(g_event_system.subscribers, 0, sizeof(g_event_system.subscribers));
     g_event_system.subscriber_count = 0;
-    g_event_system.total_published = 0;
+    cf_atomic_store(&g_event_system.total_published, 0);
 
 #if CF_MEMPOOL_ENABLED
     // Initialize event system memory pools (non-fatal if fails)
@@ -369,7 +446,7 @@ void cf_event_deinit(void)
 
 #if CF_LOG_ENABLED
     CF_LOG_I("Event system deinitialized (published %lu events)",
-             g_event_system.total_published);
+             cf_atomic_load(&g_event_system.total_published));
 #endif
 }
 
@@ -495,9 +572,9 @@ cf_status_t cf_event_publish_data(cf_event_id_t event_id,
         return CF_ERROR_NULL_POINTER;
     }
 
-    cf_mutex_lock(g_event_system.mutex, CF_WAIT_FOREVER);
+    cf_atomic_fetch_add(&g_event_system.total_published, 1);
 
-    g_event_system.total_published++;
+    cf_mutex_lock(g_event_system.mutex, CF_WAIT_FOREVER);
 
     // Deliver to all matching subscribers
     for (uint32_t i = 0; i < CF_EVENT_MAX_SUBSCRIBERS; i++) {
@@ -531,6 +608,11 @@ uint32_t cf_event_get_subscriber_count(void)
     return count;
 }
 
+uint32_t cf_event_get_total_published(void)
+{
+    return cf_atomic_load(&g_event_system.total_published);
+}
+
 uint32_t cf_event_get_event_subscriber_count(cf_event_id_t event_id)
 {
     if (!g_event_system.initialized) {
@@ -169,6 +169,15 @@ cf_status_t cf_event_publish_data(cf_event_id_t event_id,
  */
 uint32_t cf_event_get_subscriber_count(void);
 
+/**
+ * @brief Get number of events published since initialization
+ *
+ * @return Number of cf_event_publish()/cf_event_publish_data() calls
+ *
+ * @note This function is thread-safe and ISR-safe (lock-free)
+ */
+uint32_t cf_event_get_total_published(void);
+
 /**
  * @brief Get number of subscribers for specific event
  *
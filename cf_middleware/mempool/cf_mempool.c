@@ -7,6 +7,7 @@
 
 #include "cf_mempool.h"
 #include "cf_log.h"
+#include "cf_alloc.h"
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -202,8 +203,8 @@ cf_status_t cf_mempool_create(cf_mempool_handle_t* handle,
     // Calculate total memory needed
     size_t total_memory = config->block_count * config->block_size;
 
-    // Allocate pool memory (using malloc for now - could use static allocation)
-    uint8_t* memory = (uint8_t*)malloc(total_memory);
+    // Allocate pool memory (static arena with CF_STATIC_ALLOCATION)
+    uint8_t* memory = (uint8_t*)cf_alloc(total_memory);
     if (!memory) {
         cf_mutex_unlock(g_pool_manager.global_mutex);
         return CF_ERROR_NO_MEMORY;
@@ -212,7 +213,7 @@ cf_status_t cf_mempool_create(cf_mempool_handle_t* handle,
     // Initialize pool mutex
     cf_status_t status = cf_mutex_create(&pool->mutex);
     if (status != CF_OK) {
-        free(memory);
+        cf_free(memory);
         cf_mutex_unlock(g_pool_manager.global_mutex);
         return status;
     }
@@ -283,7 +284,7 @@ cf_status_t cf_mempool_destroy(cf_mempool_handle_t handle)
     cf_mutex_lock(pool->mutex, CF_WAIT_FOREVER);
 
     // Free pool memory
-    free(pool->memory_base);
+    cf_free(pool->memory_base);
 
     // Destroy pool mutex (unlock first)
     cf_mutex_unlock(pool->mutex);
@@ -7,27 +7,55 @@
 
 #if CF_THREADPOOL_ENABLED && CF_RTOS_ENABLED
 
+#include "threadpool/cf_threadpool_timer.h"
+
 #include "cf_assert.h"
-#include "os/cf_mutex.h"
+#include "os/cf_alloc.h"
+#include "os/cf_atomic.h"
 #include "os/cf_task.h"
-#include "os/cf_queue.h"
+#include "os/cf_semaphore.h"
+#include "os/cf_critical.h"
+#include "os/cf_time.h"
+#include "os/cf_timer.h"
 
-// Include FreeRTOS queue for ISR operations
+// Include FreeRTOS task API for worker notifications
 #ifdef ESP_PLATFORM
     #include "freertos/FreeRTOS.h"
-    #include "freertos/queue.h"
+    #include "freertos/task.h"
 #else
     #include "FreeRTOS.h"
-    #include "queue.h"
+    #include "task.h"
 #endif
 
 #if CF_LOG_ENABLED
     #include "utils/cf_log.h"
 #endif
 
+#if CF_THREADPOOL_TLS_INDEX >= configNUM_THREAD_LOCAL_STORAGE_POINTERS
+    #error "CF_THREADPOOL_TLS_INDEX exceeds configNUM_THREAD_LOCAL_STORAGE_POINTERS"
+#endif
+
+#if CF_THREADPOOL_STACK_CALIBRATION
+    #if defined(portSTACK_GROWTH) && (portSTACK_GROWTH > 0)
+        #error "CF_THREADPOOL_STACK_CALIBRATION supports downward-growing stacks only"
+    #endif
+    #if !defined(ESP_PLATFORM) && !configUSE_TRACE_FACILITY
+        #error "CF_THREADPOOL_STACK_CALIBRATION requires configUSE_TRACE_FACILITY (vTaskGetInfo)"
+    #endif
+#endif
+
 #include <string.h>
 #include <stdio.h>
 
+//==============================================================================
+// PRIVATE CONSTANTS
+//==============================================================================
+
+#if CF_THREADPOOL_STACK_CALIBRATION
+#define CF_THREADPOOL_STACK_PAINT   0xA5A5A5A5UL    /**< Free stack fill (matches tskSTACK_FILL_BYTE) */
+#define CF_THREADPOOL_STACK_GUARD   256             /**< Bytes left unpainted below the painting frame */
+#endif
+
 //==============================================================================
 // PRIVATE TYPES
 //==============================================================================
@@ -39,481 +67,3150 @@ typedef struct {
     cf_threadpool_task_func_t function;
     void* arg;
     cf_threadpool_priority_t priority;
+    cf_cancel_token_t* token;
+    uint32_t tag;
+    uint32_t enqueue_tick;      /**< cf_time_get_tick_count() at submission (aging) */
+    bool has_deadline;
+    bool unique;                /**< Holds an entry in the pool's key table */
+    uint32_t deadline;          /**< Absolute deadline tick (EDF) */
+    uintptr_t key;              /**< Coalescing key (unique tasks) */
+    cf_threadpool_task_func_t discard; /**< Called if dropped unrun; never evicted if set */
+#if CF_THREADPOOL_LATENCY_STATS
+    uint32_t submit_cycles;     /**< cf_time_get_cycle_count() at submission */
+#endif
+#if CF_THREADPOOL_INLINE_ARG_SIZE > 0
+    uint8_t payload_size;       /**< Bytes in payload (0 = pass arg) */
+    union {
+        uint8_t bytes[CF_THREADPOOL_INLINE_ARG_SIZE];
+        uint64_t align_u64;     /**< Force CF_THREADPOOL_INLINE_ARG_ALIGN */
+        void* align_ptr;
+    } payload;
+#endif
 } cf_threadpool_task_t;
 
 /**
- * @brief ThreadPool structure
+ * @brief Bounded task ring
+ *
+ * Used both for the shared priority queues (FIFO: push at head, pop at tail)
+ * and for per-worker deques in work-stealing mode (the owner pushes and pops
+ * at the head, other workers steal from the tail). All accesses are made
+ * with the pool critical section held.
+ */
+typedef struct {
+    cf_threadpool_task_t* slots;
+    uint32_t capacity;
+    uint32_t tail;              /**< Index of oldest task */
+    uint32_t count;
+} cf_threadpool_deque_t;
+
+/**
+ * @brief Deadline heap entry
+ *
+ * The heap orders small entries; tasks stay put in their slot.
+ */
+typedef struct {
+    uint32_t deadline;
+    uint32_t seq;               /**< Submission order, breaks deadline ties */
+    uint16_t slot;              /**< Index into edf_slots */
+} cf_threadpool_edf_entry_t;
+
+/**
+ * @brief Key table entry of a queued coalescing task (function NULL = empty)
+ */
+typedef struct {
+    cf_threadpool_task_func_t function;
+    uintptr_t key;
+} cf_threadpool_unique_entry_t;
+
+/**
+ * @brief Per-worker context
+ */
+typedef struct {
+    struct cf_threadpool_s* pool;
+    uint32_t id;
+    bool alive;                 /**< Slot holds a (starting or running) worker */
+    TaskHandle_t handle;        /**< Notified to wake the worker */
+    const cf_cancel_token_t* token; /**< Token of the running task, if any */
+    cf_threadpool_deque_t local[CF_THREADPOOL_PRIORITY_COUNT]; /**< Work-stealing deques */
+    uint8_t* scratch;           /**< Scratch arena (NULL when disabled) */
+    uint32_t scratch_used;      /**< Bytes handed out to the running task */
+    cf_task_priority_t priority; /**< Current task priority (priority_inherit) */
+    uint32_t completed;         /**< Tasks run by this slot (written by the worker only) */
+    uint32_t stack_free_min;    /**< Own stack high-water mark in bytes (written by the worker only) */
+#if CF_THREADPOOL_STACK_CALIBRATION
+    uint32_t* stack_base;       /**< Lowest stack word */
+    uint32_t* stack_dirty;      /**< Lowest word not known to hold CF_THREADPOOL_STACK_PAINT */
+#endif
+#if CF_THREADPOOL_WORKER_LOCAL_SLOTS > 0
+    void* locals[CF_THREADPOOL_WORKER_LOCAL_SLOTS]; /**< Kept for the slot's lifetime */
+#endif
+} cf_threadpool_worker_t;
+
+#if CF_THREADPOOL_LATENCY_STATS
+/**
+ * @brief Live latency counters for one priority class
  */
 typedef struct {
+    cf_atomic_u32_t count;
+    cf_atomic_u32_t wait_max_us;
+    cf_atomic_u32_t run_max_us;
+    cf_atomic_u32_t wait_hist[CF_THREADPOOL_LATENCY_BUCKETS];
+    cf_atomic_u32_t run_hist[CF_THREADPOOL_LATENCY_BUCKETS];
+} cf_threadpool_latency_counters_t;
+#endif
+
+/**
+ * @brief ThreadPool structure
+ */
+struct cf_threadpool_s {
+    struct cf_threadpool_s* next; /**< Registry link (see g_pools) */
     bool initialized;
     cf_threadpool_state_t state;
+    bool draining;              /**< Shutting down, workers may still submit */
 
     // Configuration
-    uint32_t thread_count;
+    uint32_t thread_count;      /**< Worker slots (max_threads in elastic mode) */
     uint32_t stack_size;
+    cf_task_priority_t thread_priority;
+    char name[16];
+    bool priority_inherit;
+    cf_task_priority_t job_priority[CF_THREADPOOL_PRIORITY_COUNT];
 
     // Worker threads
     cf_task_t* workers;
-
-    // Task queue (separate queues for each priority)
-    cf_queue_t queue_critical;
-    cf_queue_t queue_high;
-    cf_queue_t queue_normal;
-    cf_queue_t queue_low;
+    cf_threadpool_worker_t* worker_ctx;
+    uint32_t live_workers;
+    uint32_t peak_workers;
+
+    // Elastic mode
+    bool elastic;
+    bool spawning;              /**< Scale-up timer armed or a worker being created */
+    bool backlogged;            /**< Backlog seen at every check since the timer was armed */
+    cf_timer_t scale_timer;     /**< One-shot, fires scale_up_delay after the backlog appeared */
+    uint32_t min_workers;
+    uint32_t scale_up_threshold;
+    TickType_t idle_timeout_ticks;
+
+    // Scheduling across priority classes
+    cf_threadpool_sched_policy_t sched_policy;
+    uint8_t weights[CF_THREADPOOL_PRIORITY_COUNT];
+    uint8_t credits[CF_THREADPOOL_PRIORITY_COUNT];  /**< Weighted: dequeues left this round */
+    uint32_t aging_step_ticks;
+
+    // Deadline jobs (NULL when disabled)
+    bool drop_late;
+    uint32_t edf_capacity;
+    uint32_t edf_count;
+    uint32_t edf_seq;
+    cf_threadpool_edf_entry_t* edf_heap;
+    cf_threadpool_task_t* edf_slots;
+    uint16_t* edf_free;         /**< Free slots, edf_capacity - edf_count of them */
+
+    // Full queues
+    cf_threadpool_overload_policy_t overload[CF_THREADPOOL_PRIORITY_COUNT];
+    cf_threadpool_drop_func_t drop_callback;
+    void* drop_user_data;
+
+    // Keys of queued coalescing tasks, open addressing with linear probing
+    // (NULL when disabled)
+    cf_threadpool_unique_entry_t* unique_table;
+    uint32_t unique_mask;       /**< Table size - 1 (power of two) */
+    uint32_t unique_count;
+
+    // Work stealing (NULL when disabled)
+    bool work_stealing;
+    cf_threadpool_task_t* local_slots;
+
+    // Per-worker storage
+    uint32_t scratch_size;
+    uint8_t* scratch_mem;       /**< All arenas, scratch_size bytes per slot */
+    cf_threadpool_local_free_func_t local_free;
+
+    // Task queues (one ring per priority, guarded by the critical section)
+    cf_threadpool_deque_t queues[CF_THREADPOOL_PRIORITY_COUNT];
+    cf_threadpool_task_t* queue_slots;
+    uint32_t queued;            /**< Tasks in all rings and deques */
+    uint32_t class_queued[CF_THREADPOOL_PRIORITY_COUNT]; /**< Share of queued per class */
+    uint32_t idle_mask;         /**< Bit per parked worker */
+    uint32_t exit_pending;      /**< Poison pills not yet taken by a worker */
 
     // Synchronization
-    cf_mutex_t mutex;
-
-    // Statistics
-    uint32_t active_tasks;
-    uint32_t total_submitted;
-    uint32_t total_completed;
-
-} cf_threadpool_t;
+    cf_semaphore_t space_sem;   /**< Signalled when a slot frees up and a submitter waits */
+    uint32_t space_waiters;
+    cf_semaphore_t idle_sem;    /**< Signalled once per idle waiter when outstanding drops to 0 */
+    uint32_t idle_waiters;
+    uint32_t idle_generation;   /**< Bumped every time idle waiters are released */
+    cf_semaphore_t exit_sem;    /**< Given by each worker as it exits (shutdown join) */
+    cf_atomic_u32_t outstanding; /**< Tasks accepted but not yet finished */
+
+    // Statistics (lock-free, readable from ISR)
+    cf_atomic_u32_t active_tasks;
+    cf_atomic_u32_t total_submitted;
+    cf_atomic_u32_t total_completed;
+    cf_atomic_u32_t total_cancelled;
+    uint32_t starved[CF_THREADPOOL_PRIORITY_COUNT];     /**< Updated under the critical section */
+    uint32_t promoted[CF_THREADPOOL_PRIORITY_COUNT];
+    cf_atomic_u32_t deadline_met;
+    cf_atomic_u32_t deadline_missed;
+    cf_atomic_u32_t deadline_dropped;
+    cf_atomic_u32_t deadline_max_lateness; /**< In ticks */
+    cf_atomic_u32_t overload_blocked[CF_THREADPOOL_PRIORITY_COUNT];
+    cf_atomic_u32_t overload_rejected[CF_THREADPOOL_PRIORITY_COUNT];
+    cf_atomic_u32_t overload_caller_runs[CF_THREADPOOL_PRIORITY_COUNT];
+    cf_atomic_u32_t overload_dropped[CF_THREADPOOL_PRIORITY_COUNT];
+    cf_atomic_u32_t scratch_peak;
+    cf_atomic_u32_t scratch_failures;
+    cf_atomic_u32_t coalesced;
+#if CF_THREADPOOL_STACK_CALIBRATION
+    cf_threadpool_stack_profile_t stack_profile[CF_THREADPOOL_STACK_PROFILE_SLOTS]; /**< Guarded by the critical section */
+    uint32_t stack_profile_count;
+#endif
+#if CF_THREADPOOL_LATENCY_STATS
+    cf_threadpool_latency_counters_t latency[CF_THREADPOOL_PRIORITY_COUNT];
+#endif
+};
 
 //==============================================================================
 // PRIVATE VARIABLES
 //==============================================================================
 
-static cf_threadpool_t g_threadpool = {0};
+/** Default instance behind the global API (cf_threadpool_init() etc.) */
+static struct cf_threadpool_s g_default_pool = {0};
+
+/** Default WEIGHTED policy shares, indexed by priority */
+static const uint8_t g_default_weights[CF_THREADPOOL_PRIORITY_COUNT] = {
+    [CF_THREADPOOL_PRIORITY_LOW] = 1,
+    [CF_THREADPOOL_PRIORITY_NORMAL] = 2,
+    [CF_THREADPOOL_PRIORITY_HIGH] = 4,
+    [CF_THREADPOOL_PRIORITY_CRITICAL] = 8
+};
+
+/** Default task priority per job class when priority_inherit is set */
+static const cf_task_priority_t g_default_job_priority[CF_THREADPOOL_PRIORITY_COUNT] = {
+    [CF_THREADPOOL_PRIORITY_LOW] = CF_TASK_PRIORITY_BELOW_NORMAL,
+    [CF_THREADPOOL_PRIORITY_NORMAL] = CF_TASK_PRIORITY_NORMAL,
+    [CF_THREADPOOL_PRIORITY_HIGH] = CF_TASK_PRIORITY_ABOVE_NORMAL,
+    [CF_THREADPOOL_PRIORITY_CRITICAL] = CF_TASK_PRIORITY_HIGH
+};
+
+/** Pools with workers, so a worker can be found without knowing its pool */
+static struct cf_threadpool_s* g_pools = NULL;
 
 //==============================================================================
 // PRIVATE FUNCTIONS
 //==============================================================================
 
 /**
- * @brief Get queue for priority level
+ * @brief Map a handle to an instance (NULL selects the default instance)
+ */
+static struct cf_threadpool_s* resolve_pool(cf_threadpool_t pool)
+{
+    return (pool != NULL) ? pool : &g_default_pool;
+}
+
+/**
+ * @brief Get ring index for priority level
  */
-static cf_queue_t get_queue_for_priority(cf_threadpool_priority_t priority)
+static uint32_t get_queue_index(cf_threadpool_priority_t priority)
 {
     switch (priority) {
         case CF_THREADPOOL_PRIORITY_CRITICAL:
-            return g_threadpool.queue_critical;
         case CF_THREADPOOL_PRIORITY_HIGH:
-            return g_threadpool.queue_high;
         case CF_THREADPOOL_PRIORITY_LOW:
-            return g_threadpool.queue_low;
+            return (uint32_t)priority;
         case CF_THREADPOOL_PRIORITY_NORMAL:
         default:
-            return g_threadpool.queue_normal;
+            return CF_THREADPOOL_PRIORITY_NORMAL;
     }
 }
 
 /**
- * @brief Try to get next task from queues (priority order)
+ * @brief Push task at the head of a ring (critical section held)
  */
-static bool get_next_task(cf_threadpool_task_t* task)
+static bool deque_push_head(cf_threadpool_deque_t* dq, const cf_threadpool_task_t* task)
 {
-    // Try critical priority first
-    if (cf_queue_receive(g_threadpool.queue_critical, task, 0) == CF_OK) {
-        return true;
-    }
-
-    // Try high priority
-    if (cf_queue_receive(g_threadpool.queue_high, task, 0) == CF_OK) {
-        return true;
+    if (dq->count >= dq->capacity) {
+        return false;
     }
 
-    // Try normal priority
-    if (cf_queue_receive(g_threadpool.queue_normal, task, 0) == CF_OK) {
-        return true;
-    }
+    dq->slots[(dq->tail + dq->count) % dq->capacity] = *task;
+    dq->count++;
+    return true;
+}
 
-    // Try low priority
-    if (cf_queue_receive(g_threadpool.queue_low, task, 0) == CF_OK) {
-        return true;
+/**
+ * @brief Pop newest task from the head of a ring (critical section held)
+ */
+static bool deque_pop_head(cf_threadpool_deque_t* dq, cf_threadpool_task_t* task)
+{
+    if (dq->count == 0) {
+        return false;
     }
 
-    return false;
+    dq->count--;
+    *task = dq->slots[(dq->tail + dq->count) % dq->capacity];
+    return true;
 }
 
 /**
- * @brief Worker thread function
+ * @brief Pop oldest task from the tail of a ring (critical section held)
  */
-static void worker_thread(void* arg)
+static bool deque_pop_tail(cf_threadpool_deque_t* dq, cf_threadpool_task_t* task)
 {
-    uint32_t worker_id = (uint32_t)(uintptr_t)arg;
-    cf_threadpool_task_t task;
+    if (dq->count == 0) {
+        return false;
+    }
 
-#if CF_LOG_ENABLED
-    CF_LOG_D("ThreadPool worker %lu started", worker_id);
-#endif
+    *task = dq->slots[dq->tail];
+    dq->tail = (dq->tail + 1) % dq->capacity;
+    dq->count--;
+    return true;
+}
 
-    while (g_threadpool.state == CF_THREADPOOL_RUNNING) {
-        // Try to get task from queues (blocking with timeout)
-        bool got_task = false;
+/**
+ * @brief Find the worker context of the calling task
+ *
+ * @return Worker context, or NULL if not called from a worker of this pool
+ */
+static cf_threadpool_worker_t* find_current_worker(struct cf_threadpool_s* pool)
+{
+    if (pool->worker_ctx == NULL) {
+        return NULL;
+    }
 
-        // Try critical first (non-blocking)
-        if (cf_queue_receive(g_threadpool.queue_critical, &task, 0) == CF_OK) {
-            got_task = true;
-        }
-        // Try high
-        else if (cf_queue_receive(g_threadpool.queue_high, &task, 0) == CF_OK) {
-            got_task = true;
-        }
-        // Try normal (with timeout to allow checking state)
-        else if (cf_queue_receive(g_threadpool.queue_normal, &task, 100) == CF_OK) {
-            got_task = true;
-        }
-        // Try low
-        else if (cf_queue_receive(g_threadpool.queue_low, &task, 0) == CF_OK) {
-            got_task = true;
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    for (uint32_t i = 0; i < pool->thread_count; i++) {
+        if (pool->worker_ctx[i].handle == self) {
+            return &pool->worker_ctx[i];
         }
+    }
 
-        if (got_task && task.function != NULL) {
-            // Update active count
-            cf_mutex_lock(g_threadpool.mutex, CF_WAIT_FOREVER);
-            g_threadpool.active_tasks++;
-            cf_mutex_unlock(g_threadpool.mutex);
+    return NULL;
+}
 
-            // Execute task
-            task.function(task.arg);
+#if CF_THREADPOOL_TLS_INDEX < 0
+/**
+ * @brief Find the worker context of the calling task in any pool
+ *
+ * @return Worker context, or NULL if not called from a ThreadPool worker
+ */
+static cf_threadpool_worker_t* find_current_worker_any(void)
+{
+    cf_threadpool_worker_t* worker = NULL;
 
-            // Update statistics
-            cf_mutex_lock(g_threadpool.mutex, CF_WAIT_FOREVER);
-            g_threadpool.active_tasks--;
-            g_threadpool.total_completed++;
-            cf_mutex_unlock(g_threadpool.mutex);
-        }
+    cf_critical_section_enter();
+    for (struct cf_threadpool_s* pool = g_pools; pool != NULL && worker == NULL; pool = pool->next) {
+        worker = find_current_worker(pool);
     }
+    cf_critical_section_exit();
 
-#if CF_LOG_ENABLED
-    CF_LOG_D("ThreadPool worker %lu stopped", worker_id);
+    // The caller's own pool cannot go away while it runs a task
+    return worker;
+}
+#endif
+
+/**
+ * @brief Worker context of the calling task, O(1) when a TLS index is set
+ */
+static cf_threadpool_worker_t* current_worker(void)
+{
+#if CF_THREADPOOL_TLS_INDEX >= 0
+    return (cf_threadpool_worker_t*)pvTaskGetThreadLocalStoragePointer(NULL, CF_THREADPOOL_TLS_INDEX);
+#else
+    return find_current_worker_any();
 #endif
 }
 
 /**
- * @brief Create worker threads
+ * @brief Add an instance to the registry
  */
-static cf_status_t create_workers(uint32_t count, uint32_t stack_size, cf_task_priority_t priority)
+static void register_pool(struct cf_threadpool_s* pool)
 {
-    g_threadpool.workers = (cf_task_t*)pvPortMalloc(count * sizeof(cf_task_t));
-    if (g_threadpool.workers == NULL) {
-        return CF_ERROR_NO_MEMORY;
+    cf_critical_section_enter();
+    pool->next = g_pools;
+    g_pools = pool;
+    cf_critical_section_exit();
+}
+
+/**
+ * @brief Remove an instance from the registry (before its workers are freed)
+ */
+static void unregister_pool(struct cf_threadpool_s* pool)
+{
+    cf_critical_section_enter();
+    for (struct cf_threadpool_s** link = &g_pools; *link != NULL; link = &(*link)->next) {
+        if (*link == pool) {
+            *link = pool->next;
+            break;
+        }
     }
+    pool->next = NULL;
+    cf_critical_section_exit();
+}
 
-    memset(g_threadpool.workers, 0, count * sizeof(cf_task_t));
+/**
+ * @brief Deadline heap order: earlier deadline first, then submission order
+ */
+static bool edf_before(const cf_threadpool_edf_entry_t* a, const cf_threadpool_edf_entry_t* b)
+{
+    int32_t diff = (int32_t)(a->deadline - b->deadline);
 
-    cf_task_config_t task_config;
-    cf_task_config_default(&task_config);
-    task_config.function = worker_thread;
-    task_config.stack_size = stack_size;
-    task_config.priority = priority;
+    return diff < 0 || (diff == 0 && (int32_t)(a->seq - b->seq) < 0);
+}
 
-    for (uint32_t i = 0; i < count; i++) {
-        char name[32];
-        snprintf(name, sizeof(name), "Worker%lu", i);
-        task_config.name = name;
-        task_config.argument = (void*)(uintptr_t)i;
+/**
+ * @brief Restore the heap order below an entry (critical section held)
+ */
+static void edf_sift_down(struct cf_threadpool_s* pool, uint32_t i)
+{
+    cf_threadpool_edf_entry_t* heap = pool->edf_heap;
+    cf_threadpool_edf_entry_t entry = heap[i];
 
-        cf_status_t status = cf_task_create(&g_threadpool.workers[i], &task_config);
-        if (status != CF_OK) {
-            // Cleanup previously created workers
-            for (uint32_t j = 0; j < i; j++) {
-                cf_task_delete(g_threadpool.workers[j]);
-            }
-            vPortFree(g_threadpool.workers);
-            g_threadpool.workers = NULL;
-            return status;
+    for (;;) {
+        uint32_t child = 2 * i + 1;
+        if (child >= pool->edf_count) {
+            break;
+        }
+        if (child + 1 < pool->edf_count && edf_before(&heap[child + 1], &heap[child])) {
+            child++;
         }
+        if (!edf_before(&heap[child], &entry)) {
+            break;
+        }
+        heap[i] = heap[child];
+        i = child;
     }
 
-    return CF_OK;
+    heap[i] = entry;
 }
 
 /**
- * @brief Destroy worker threads
+ * @brief Restore the heap order above an entry (critical section held)
  */
-static void destroy_workers(void)
+static void edf_sift_up(struct cf_threadpool_s* pool, uint32_t i)
 {
-    if (g_threadpool.workers == NULL) {
-        return;
-    }
+    cf_threadpool_edf_entry_t* heap = pool->edf_heap;
+    cf_threadpool_edf_entry_t entry = heap[i];
 
-    // Set state to shutting down
-    g_threadpool.state = CF_THREADPOOL_SHUTTING_DOWN;
+    while (i > 0 && edf_before(&entry, &heap[(i - 1) / 2])) {
+        heap[i] = heap[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
 
-    // Wait a bit for workers to finish current tasks
-    cf_task_delay(100);
+    heap[i] = entry;
+}
 
-    // Delete all workers
-    for (uint32_t i = 0; i < g_threadpool.thread_count; i++) {
-        if (g_threadpool.workers[i] != NULL) {
-            cf_task_delete(g_threadpool.workers[i]);
-        }
+/**
+ * @brief Add a deadline task (critical section held)
+ */
+static bool edf_push(struct cf_threadpool_s* pool, const cf_threadpool_task_t* task)
+{
+    if (pool->edf_count >= pool->edf_capacity) {
+        return false;
     }
 
-    vPortFree(g_threadpool.workers);
-    g_threadpool.workers = NULL;
-}
+    uint16_t slot = pool->edf_free[pool->edf_capacity - pool->edf_count - 1];
+    pool->edf_slots[slot] = *task;
 
-//==============================================================================
-// PUBLIC API IMPLEMENTATION
-//==============================================================================
+    cf_threadpool_edf_entry_t entry = {
+        .deadline = task->deadline,
+        .seq = pool->edf_seq++,
+        .slot = slot
+    };
 
-cf_status_t cf_threadpool_init(void)
-{
-    cf_threadpool_config_t config;
-    cf_threadpool_config_default(&config);
-    return cf_threadpool_init_with_config(&config);
+    pool->edf_heap[pool->edf_count] = entry;
+    edf_sift_up(pool, pool->edf_count++);
+
+    return true;
 }
 
-cf_status_t cf_threadpool_init_with_config(const cf_threadpool_config_t* config)
+/**
+ * @brief Remove the deadline task at a heap position (critical section held)
+ */
+static void edf_remove_at(struct cf_threadpool_s* pool, uint32_t i, cf_threadpool_task_t* task)
 {
-    CF_PTR_CHECK(config);
-
-    if (g_threadpool.initialized) {
-        return CF_ERROR_ALREADY_INITIALIZED;
+    uint16_t slot = pool->edf_heap[i].slot;
+    *task = pool->edf_slots[slot];
+
+    pool->edf_count--;
+    pool->edf_free[pool->edf_capacity - pool->edf_count - 1] = slot;
+    if (i < pool->edf_count) {
+        pool->edf_heap[i] = pool->edf_heap[pool->edf_count];
+        edf_sift_up(pool, i);
+        edf_sift_down(pool, i);
     }
+}
 
-    if (config->thread_count == 0 || config->queue_size == 0 || config->stack_size == 0) {
-        return CF_ERROR_INVALID_PARAM;
+/**
+ * @brief Remove the task with the earliest deadline (critical section held)
+ */
+static bool edf_pop(struct cf_threadpool_s* pool, cf_threadpool_task_t* task)
+{
+    if (pool->edf_count == 0) {
+        return false;
     }
 
-    memset(&g_threadpool, 0, sizeof(cf_threadpool_t));
-
-    // Create mutex
-    cf_status_t status = cf_mutex_create(&g_threadpool.mutex);
-    if (status != CF_OK) {
-        return status;
-    }
+    edf_remove_at(pool, 0, task);
+    return true;
+}
 
-    // Create queues for each priority
-    status = cf_queue_create(&g_threadpool.queue_critical, config->queue_size, sizeof(cf_threadpool_task_t));
-    if (status != CF_OK) {
-        goto cleanup;
+/**
+ * @brief Discard every deadline task (critical section held)
+ */
+static void edf_clear(struct cf_threadpool_s* pool)
+{
+    pool->edf_count = 0;
+    for (uint32_t i = 0; i < pool->edf_capacity; i++) {
+        pool->edf_free[i] = (uint16_t)i;
     }
+}
 
-    status = cf_queue_create(&g_threadpool.queue_high, config->queue_size, sizeof(cf_threadpool_task_t));
-    if (status != CF_OK) {
-        goto cleanup;
-    }
+/**
+ * @brief Home slot of a (function, key) pair in the key table
+ */
+static uint32_t unique_hash(struct cf_threadpool_s* pool,
+                            cf_threadpool_task_func_t function,
+                            uintptr_t key)
+{
+    uint64_t wide = (uint64_t)key;
+    uint32_t h = (uint32_t)((uintptr_t)function >> 2) * 0x9E3779B1UL;
 
-    status = cf_queue_create(&g_threadpool.queue_normal, config->queue_size * 2, sizeof(cf_threadpool_task_t));
-    if (status != CF_OK) {
-        goto cleanup;
-    }
+    h ^= ((uint32_t)wide ^ (uint32_t)(wide >> 32)) * 0x85EBCA6BUL;
+    h ^= h >> 16;
 
-    status = cf_queue_create(&g_threadpool.queue_low, config->queue_size, sizeof(cf_threadpool_task_t));
-    if (status != CF_OK) {
-        goto cleanup;
-    }
+    return h & pool->unique_mask;
+}
 
-    // Save configuration
-    g_threadpool.thread_count = config->thread_count;
-    g_threadpool.stack_size = config->stack_size;
-    g_threadpool.state = CF_THREADPOOL_RUNNING;
+/**
+ * @brief Find a key, or the empty slot ending its probe run (critical section held)
+ */
+static uint32_t unique_probe(struct cf_threadpool_s* pool,
+                             cf_threadpool_task_func_t function,
+                             uintptr_t key)
+{
+    uint32_t i = unique_hash(pool, function, key);
 
-    // Create worker threads
-    status = create_workers(config->thread_count, config->stack_size, config->thread_priority);
-    if (status != CF_OK) {
-        goto cleanup;
+    while (pool->unique_table[i].function != NULL &&
+           (pool->unique_table[i].function != function || pool->unique_table[i].key != key)) {
+        i = (i + 1) & pool->unique_mask;
     }
 
-    g_threadpool.initialized = true;
-
-#if CF_LOG_ENABLED
-    CF_LOG_I("ThreadPool initialized: %lu workers, queue size %lu",
-             config->thread_count, config->queue_size);
-#endif
+    return i;
+}
 
-    return CF_OK;
+/**
+ * @brief Record the key of a task about to be queued (critical section held)
+ *
+ * The table is kept at most three quarters full to bound probe runs.
+ *
+ * @return false if the table is too full; the task then does not coalesce
+ */
+static bool unique_insert(struct cf_threadpool_s* pool, const cf_threadpool_task_t* task)
+{
+    if (pool->unique_count >= (pool->unique_mask + 1) - (pool->unique_mask + 1) / 4) {
+        return false;
+    }
 
-cleanup:
-    if (g_threadpool.queue_critical) cf_queue_destroy(g_threadpool.queue_critical);
-    if (g_threadpool.queue_high) cf_queue_destroy(g_threadpool.queue_high);
-    if (g_threadpool.queue_normal) cf_queue_destroy(g_threadpool.queue_normal);
-    if (g_threadpool.queue_low) cf_queue_destroy(g_threadpool.queue_low);
-    if (g_threadpool.mutex) cf_mutex_destroy(g_threadpool.mutex);
+    uint32_t i = unique_probe(pool, task->function, task->key);
+    pool->unique_table[i].function = task->function;
+    pool->unique_table[i].key = task->key;
+    pool->unique_count++;
 
-    memset(&g_threadpool, 0, sizeof(cf_threadpool_t));
-    return status;
+    return true;
 }
 
-void cf_threadpool_deinit(bool wait_for_tasks)
+/**
+ * @brief Forget the key of a task leaving the queue (critical section held)
+ *
+ * Later entries of the probe run are shifted back instead of leaving a
+ * tombstone, so lookups never degrade.
+ */
+static void unique_remove(struct cf_threadpool_s* pool, const cf_threadpool_task_t* task)
 {
-    if (!g_threadpool.initialized) {
+    if (!task->unique) {
         return;
     }
 
-    if (wait_for_tasks) {
-        // Wait for all tasks to complete (with timeout)
-        cf_threadpool_wait_idle(5000);
-    }
-
-    // Destroy workers
-    destroy_workers();
-
-    // Destroy queues
-    cf_queue_destroy(g_threadpool.queue_critical);
-    cf_queue_destroy(g_threadpool.queue_high);
-    cf_queue_destroy(g_threadpool.queue_normal);
-    cf_queue_destroy(g_threadpool.queue_low);
+    uint32_t mask = pool->unique_mask;
+    uint32_t hole = unique_probe(pool, task->function, task->key);
+    uint32_t i = hole;
 
-    // Destroy mutex
-    cf_mutex_destroy(g_threadpool.mutex);
+    for (;;) {
+        i = (i + 1) & mask;
+        if (pool->unique_table[i].function == NULL) {
+            break;
+        }
 
-    g_threadpool.initialized = false;
-    g_threadpool.state = CF_THREADPOOL_STOPPED;
+        // Move the entry into the hole unless its home lies in (hole, i]
+        uint32_t home = unique_hash(pool, pool->unique_table[i].function, pool->unique_table[i].key);
+        if (((i - home) & mask) >= ((i - hole) & mask)) {
+            pool->unique_table[hole] = pool->unique_table[i];
+            hole = i;
+        }
+    }
 
-#if CF_LOG_ENABLED
-    CF_LOG_I("ThreadPool deinitialized (completed %lu tasks)",
-             g_threadpool.total_completed);
-#endif
+    pool->unique_table[hole].function = NULL;
+    pool->unique_count--;
 }
 
-cf_status_t cf_threadpool_submit(cf_threadpool_task_func_t function,
-                                  void* arg,
-                                  cf_threadpool_priority_t priority,
-                                  uint32_t timeout_ms)
+/**
+ * @brief Enqueue one task (critical section held)
+ *
+ * Tasks spawned by a work-stealing worker go to its own deque; everything
+ * else (or overflow from a full deque) goes to the shared ring.
+ */
+static bool enqueue_task(struct cf_threadpool_s* pool,
+                         cf_threadpool_worker_t* self,
+                         const cf_threadpool_task_t* task)
 {
-    CF_PTR_CHECK(function);
+    uint32_t index = get_queue_index(task->priority);
 
-    if (!g_threadpool.initialized) {
-        return CF_ERROR_NOT_INITIALIZED;
+    if (task->has_deadline) {
+        if (!edf_push(pool, task)) {
+            return false;
+        }
+        pool->queued++;
+        return true;
     }
 
-    if (g_threadpool.state != CF_THREADPOOL_RUNNING) {
-        return CF_ERROR_INVALID_STATE;
+    if (self != NULL && pool->work_stealing &&
+        deque_push_head(&self->local[index], task)) {
+        pool->queued++;
+        pool->class_queued[index]++;
+        return true;
     }
 
-    // Create task descriptor
-    cf_threadpool_task_t task = {
-        .function = function,
-        .arg = arg,
-        .priority = priority
-    };
+    if (deque_push_head(&pool->queues[index], task)) {
+        pool->queued++;
+        pool->class_queued[index]++;
+        return true;
+    }
 
-    // Get queue for this priority
-    cf_queue_t queue = get_queue_for_priority(priority);
+    return false;
+}
 
-    // Submit to queue
-    cf_status_t status = cf_queue_send(queue, &task, timeout_ms);
-    if (status != CF_OK) {
-        return status;
+/**
+ * @brief Evict the oldest deadline task without a discard hook (critical section held)
+ */
+static bool edf_evict(struct cf_threadpool_s* pool, cf_threadpool_task_t* evicted)
+{
+    uint32_t best = pool->edf_count;
+
+    for (uint32_t i = 0; i < pool->edf_count; i++) {
+        if (pool->edf_slots[pool->edf_heap[i].slot].discard == NULL &&
+            (best == pool->edf_count || edf_before(&pool->edf_heap[i], &pool->edf_heap[best]))) {
+            best = i;
+            if (i == 0) {
+                break;
+            }
+        }
     }
 
-    // Update statistics
-    cf_mutex_lock(g_threadpool.mutex, CF_WAIT_FOREVER);
-    g_threadpool.total_submitted++;
-    cf_mutex_unlock(g_threadpool.mutex);
+    if (best == pool->edf_count) {
+        return false;
+    }
 
-    return CF_OK;
+    edf_remove_at(pool, best, evicted);
+    return true;
 }
 
-cf_status_t cf_threadpool_submit_from_isr(cf_threadpool_task_func_t function,
-                                           void* arg,
-                                           cf_threadpool_priority_t priority,
-                                           uint32_t timeout_ms,
-                                           BaseType_t* pxHigherPriorityTaskWoken)
+/**
+ * @brief Evict the oldest task of a ring without a discard hook (critical section held)
+ *
+ * Older tasks that are skipped move up one slot, so the order is kept.
+ */
+static bool deque_evict(cf_threadpool_deque_t* dq, cf_threadpool_task_t* evicted)
 {
-    CF_PTR_CHECK(function);
+    uint32_t i = 0;
 
-    if (!g_threadpool.initialized) {
-        return CF_ERROR_NOT_INITIALIZED;
+    while (i < dq->count && dq->slots[(dq->tail + i) % dq->capacity].discard != NULL) {
+        i++;
     }
 
-    if (g_threadpool.state != CF_THREADPOOL_RUNNING) {
-        return CF_ERROR_INVALID_STATE;
+    if (i == dq->count) {
+        return false;
     }
 
-    // Timeout must be 0 in ISR
-    if (timeout_ms != 0) {
-        return CF_ERROR_INVALID_PARAM;
+    *evicted = dq->slots[(dq->tail + i) % dq->capacity];
+    for (; i > 0; i--) {
+        dq->slots[(dq->tail + i) % dq->capacity] = dq->slots[(dq->tail + i - 1) % dq->capacity];
     }
+    dq->tail = (dq->tail + 1) % dq->capacity;
+    dq->count--;
 
-    // Create task descriptor
-    cf_threadpool_task_t task = {
-        .function = function,
-        .arg = arg,
-        .priority = priority
-    };
+    return true;
+}
 
-    // Get queue for this priority
-    cf_queue_t queue = get_queue_for_priority(priority);
+/**
+ * @brief Evict the stalest task competing with task for space (critical section held)
+ *
+ * That is the oldest task of the class's shared ring, or the earliest
+ * deadline for a deadline task. Tasks with a discard hook are skipped: the
+ * hook must not run in the submitter's (possibly ISR) context, and the
+ * helper tasks of futures, strands, graphs etc., which all have one, must
+ * not get lost.
+ */
+static bool evict_oldest(struct cf_threadpool_s* pool,
+                         const cf_threadpool_task_t* task,
+                         cf_threadpool_task_t* evicted)
+{
+    uint32_t index = get_queue_index(task->priority);
 
-    // Access underlying FreeRTOS queue handle for ISR-safe operation
-    // cf_queue_t is defined in cf_queue.c as: struct cf_queue_s { QueueHandle_t handle; }
-    // We need to access the handle directly to use xQueueSendFromISR
-    struct cf_queue_s {
-        QueueHandle_t handle;
-    };
-    struct cf_queue_s* q = (struct cf_queue_s*)queue;
+    if (task->has_deadline) {
+        if (!edf_evict(pool, evicted)) {
+            return false;
+        }
+    } else {
+        if (!deque_evict(&pool->queues[index], evicted)) {
+            return false;
+        }
+        pool->class_queued[index]--;
+    }
+    pool->queued--;
+    unique_remove(pool, evicted);
 
-    // Submit to queue from ISR (non-blocking)
+    return true;
+}
+
+/**
+ * @brief Claim up to count parked workers for waking (critical section held)
+ *
+ * @return Mask of claimed workers, to be passed to notify_workers()
+ */
+static uint32_t claim_idle_workers(struct cf_threadpool_s* pool, uint32_t count)
+{
+    uint32_t claimed = 0;
+
+    while (count > 0 && pool->idle_mask != 0) {
+        uint32_t bit = pool->idle_mask & (~pool->idle_mask + 1);
+        pool->idle_mask &= ~bit;
+        claimed |= bit;
+        count--;
+    }
+
+    return claimed;
+}
+
+/**
+ * @brief Notify claimed workers (task context, outside the critical section)
+ */
+static void notify_workers(struct cf_threadpool_s* pool, uint32_t mask)
+{
+    for (uint32_t i = 0; mask != 0 && i < pool->thread_count; i++) {
+        if ((mask & (1UL << i)) != 0 && pool->worker_ctx[i].handle != NULL) {
+            xTaskNotifyGive(pool->worker_ctx[i].handle);
+        }
+        mask &= ~(1UL << i);
+    }
+}
+
+/**
+ * @brief Notify claimed workers from ISR context
+ */
+static void notify_workers_from_isr(struct cf_threadpool_s* pool,
+                                    uint32_t mask,
+                                    BaseType_t* pxHigherPriorityTaskWoken)
+{
+    for (uint32_t i = 0; mask != 0 && i < pool->thread_count; i++) {
+        if ((mask & (1UL << i)) != 0 && pool->worker_ctx[i].handle != NULL) {
+            vTaskNotifyGiveFromISR(pool->worker_ctx[i].handle, pxHigherPriorityTaskWoken);
+        }
+        mask &= ~(1UL << i);
+    }
+}
+
+/**
+ * @brief Validate a job descriptor for a pool
+ */
+static cf_status_t check_job(struct cf_threadpool_s* pool, const cf_threadpool_job_t* job)
+{
+    CF_PTR_CHECK(job->function);
+
+    if ((job->has_deadline && pool->edf_capacity == 0) ||
+        (job->coalesce && pool->unique_table == NULL)) {
+        return CF_ERROR_NOT_SUPPORTED;
+    }
+
+    if (job->data_size > 0) {
+        CF_PTR_CHECK(job->data);
+        if (job->data_size > CF_THREADPOOL_INLINE_ARG_SIZE) {
+            return CF_ERROR_INVALID_PARAM;
+        }
+    }
+
+    return CF_OK;
+}
+
+/**
+ * @brief Check whether submissions are accepted (critical section held)
+ *
+ * While a waiting shutdown drains the pool, the pool's own workers may still
+ * submit follow-up tasks; everyone else is turned away.
+ */
+static bool accepts_jobs(struct cf_threadpool_s* pool, cf_threadpool_worker_t* self)
+{
+    return pool->state == CF_THREADPOOL_RUNNING || (pool->draining && self != NULL);
+}
+
+/**
+ * @brief Account for finished (or discarded) tasks and release idle waiters
+ */
+static void retire_tasks(struct cf_threadpool_s* pool, uint32_t count)
+{
+    if (count == 0 || cf_atomic_fetch_sub(&pool->outstanding, count) != count) {
+        return;
+    }
+
+    // Last outstanding task: wake everyone blocked in wait_idle
+    cf_critical_section_enter();
+    uint32_t waiters = pool->idle_waiters;
+    pool->idle_waiters = 0;
+    pool->idle_generation++;
+    cf_critical_section_exit();
+
+    while (waiters-- > 0) {
+        cf_semaphore_give(pool->idle_sem);
+    }
+}
+
+/**
+ * @brief Drop a dequeued task without running it (task context)
+ */
+static void discard_task(struct cf_threadpool_s* pool, const cf_threadpool_task_t* task)
+{
+    if (task->discard != NULL) {
+        void* arg = task->arg;
+#if CF_THREADPOOL_INLINE_ARG_SIZE > 0
+        if (task->payload_size > 0) {
+            arg = (void*)task->payload.bytes;
+        }
+#endif
+        task->discard(arg);
+    }
+
+    retire_tasks(pool, 1);
+}
+
+/**
+ * @brief Remove any one queued task (critical section held)
+ */
+static bool take_queued(struct cf_threadpool_s* pool, cf_threadpool_task_t* task)
+{
+    bool found = edf_pop(pool, task);
+
+    for (uint32_t prio = 0; !found && prio < CF_THREADPOOL_PRIORITY_COUNT; prio++) {
+        found = deque_pop_tail(&pool->queues[prio], task);
+        for (uint32_t i = 0; !found && pool->work_stealing && i < pool->thread_count; i++) {
+            found = deque_pop_tail(&pool->worker_ctx[i].local[prio], task);
+        }
+        if (found) {
+            pool->class_queued[prio]--;
+        }
+    }
+
+    if (found) {
+        pool->queued--;
+        unique_remove(pool, task);
+    }
+
+    return found;
+}
+
+/**
+ * @brief Discard every queued task
+ *
+ * Called once submissions are refused. Tasks are taken one per critical
+ * section so that discard hooks run outside it.
+ */
+static void discard_queued(struct cf_threadpool_s* pool)
+{
+    cf_threadpool_task_t task;
+
+    for (;;) {
+        cf_critical_section_enter();
+        bool found = take_queued(pool, &task);
+        cf_critical_section_exit();
+
+        if (!found) {
+            break;
+        }
+        discard_task(pool, &task);
+    }
+}
+
+/**
+ * @brief Remove tasks with a tag from a ring, keeping order (critical section held)
+ *
+ * Of the tasks with a discard hook only the first is removed, into hooked
+ * (if hooked->function is still NULL); the caller runs its hook and calls
+ * again for the next.
+ *
+ * @return Number of tasks removed
+ */
+static uint32_t deque_remove_tagged(struct cf_threadpool_s* pool,
+                                    cf_threadpool_deque_t* dq,
+                                    uint32_t tag,
+                                    cf_threadpool_task_t* hooked)
+{
+    uint32_t kept = 0;
+
+    for (uint32_t i = 0; i < dq->count; i++) {
+        cf_threadpool_task_t* task = &dq->slots[(dq->tail + i) % dq->capacity];
+        if (task->tag == tag && (task->discard == NULL || hooked->function == NULL)) {
+            if (task->discard != NULL) {
+                *hooked = *task;
+            }
+            unique_remove(pool, task);
+            continue;
+        }
+        if (kept != i) {
+            dq->slots[(dq->tail + kept) % dq->capacity] = *task;
+        }
+        kept++;
+    }
+
+    uint32_t removed = dq->count - kept;
+    dq->count = kept;
+    return removed;
+}
+
+/**
+ * @brief Remove deadline tasks with a tag (critical section held)
+ *
+ * Tasks with a discard hook are handled as in deque_remove_tagged().
+ *
+ * @return Number of tasks removed
+ */
+static uint32_t edf_remove_tagged(struct cf_threadpool_s* pool, uint32_t tag, cf_threadpool_task_t* hooked)
+{
+    uint32_t kept = 0;
+    uint32_t removed = 0;
+
+    for (uint32_t i = 0; i < pool->edf_count; i++) {
+        cf_threadpool_edf_entry_t entry = pool->edf_heap[i];
+        cf_threadpool_task_t* task = &pool->edf_slots[entry.slot];
+        if (task->tag == tag && (task->discard == NULL || hooked->function == NULL)) {
+            if (task->discard != NULL) {
+                *hooked = *task;
+            }
+            unique_remove(pool, task);
+            pool->edf_free[pool->edf_capacity - pool->edf_count + removed] = entry.slot;
+            removed++;
+        } else {
+            pool->edf_heap[kept++] = entry;
+        }
+    }
+
+    pool->edf_count = kept;
+    for (uint32_t i = kept / 2; i-- > 0;) {
+        edf_sift_down(pool, i);
+    }
+
+    return removed;
+}
+
+/**
+ * @brief Account for a finished deadline task
+ */
+static void record_deadline(struct cf_threadpool_s* pool, const cf_threadpool_task_t* task)
+{
+    uint32_t lateness = cf_time_get_tick_count() - task->deadline;
+
+    if ((int32_t)lateness > 0) {
+        cf_atomic_fetch_add(&pool->deadline_missed, 1);
+        cf_atomic_store_max(&pool->deadline_max_lateness, lateness);
+    } else {
+        cf_atomic_fetch_add(&pool->deadline_met, 1);
+    }
+}
+
+static void worker_thread(void* arg);
+
+#if CF_THREADPOOL_LATENCY_STATS
+/**
+ * @brief Get log2 histogram bucket for a duration
+ */
+static uint32_t latency_bucket(uint32_t us)
+{
+    uint32_t bucket = 0;
+
+    while (us != 0 && bucket < CF_THREADPOOL_LATENCY_BUCKETS - 1) {
+        us >>= 1;
+        bucket++;
+    }
+
+    return bucket;
+}
+
+/**
+ * @brief Record queue wait and run time of a finished task
+ */
+static void record_latency(struct cf_threadpool_s* pool,
+                           const cf_threadpool_task_t* task,
+                           uint32_t start_cycles,
+                           uint32_t end_cycles)
+{
+    cf_threadpool_latency_counters_t* cls = &pool->latency[get_queue_index(task->priority)];
+    uint32_t wait_us = cf_time_cycles_to_us(start_cycles - task->submit_cycles);
+    uint32_t run_us = cf_time_cycles_to_us(end_cycles - start_cycles);
+
+    cf_atomic_fetch_add(&cls->count, 1);
+    cf_atomic_fetch_add(&cls->wait_hist[latency_bucket(wait_us)], 1);
+    cf_atomic_fetch_add(&cls->run_hist[latency_bucket(run_us)], 1);
+    cf_atomic_store_max(&cls->wait_max_us, wait_us);
+    cf_atomic_store_max(&cls->run_max_us, run_us);
+}
+#endif /* CF_THREADPOOL_LATENCY_STATS */
+
+/**
+ * @brief Start a worker in a free slot
+ */
+static cf_status_t spawn_worker(struct cf_threadpool_s* pool, uint32_t slot)
+{
+    cf_task_config_t task_config;
+    char name[32];
+
+    cf_task_config_default(&task_config);
+    snprintf(name, sizeof(name), "%s%lu", pool->name, slot);
+    task_config.name = name;
+    task_config.function = worker_thread;
+    task_config.argument = &pool->worker_ctx[slot];
+    task_config.stack_size = pool->stack_size;
+    task_config.priority = pool->thread_priority;
+
+    return cf_task_create(&pool->workers[slot], &task_config);
+}
+
+/**
+ * @brief Check whether the pool needs another worker (critical section held)
+ */
+static bool scale_up_needed(const struct cf_threadpool_s* pool)
+{
+    return pool->state == CF_THREADPOOL_RUNNING && pool->idle_mask == 0 &&
+           pool->queued > pool->scale_up_threshold &&
+           pool->live_workers < pool->thread_count;
+}
+
+/**
+ * @brief Scale-up timer callback (timer service task)
+ *
+ * Adds one worker if the backlog was seen at every check since the timer
+ * was armed, so a short burst does not cost a stack that is retired again
+ * after the idle timeout. The next check re-arms the timer while the
+ * backlog persists, adding at most one worker per scale_up_delay.
+ */
+static void scale_up_tick(cf_timer_t timer, void* arg)
+{
+    (void)timer;
+
+    struct cf_threadpool_s* pool = (struct cf_threadpool_s*)arg;
+    int32_t slot = -1;
+
+    cf_critical_section_enter();
+    if (pool->backlogged && scale_up_needed(pool)) {
+        for (uint32_t i = 0; i < pool->thread_count; i++) {
+            if (!pool->worker_ctx[i].alive) {
+                slot = (int32_t)i;
+                pool->worker_ctx[i].alive = true;
+                pool->live_workers++;
+                if (pool->live_workers > pool->peak_workers) {
+                    pool->peak_workers = pool->live_workers;
+                }
+                break;
+            }
+        }
+    }
+    if (slot < 0) {
+        pool->backlogged = false;
+        pool->spawning = false;
+    }
+    cf_critical_section_exit();
+
+    if (slot < 0) {
+        return;
+    }
+
+    cf_status_t status = spawn_worker(pool, (uint32_t)slot);
+
+    cf_critical_section_enter();
+    if (status != CF_OK) {
+        pool->worker_ctx[slot].alive = false;
+        pool->live_workers--;
+    }
+    pool->backlogged = false;
+    pool->spawning = false;
+    cf_critical_section_exit();
+
+#if CF_LOG_ENABLED
+    if (status == CF_OK) {
+        CF_LOG_D("ThreadPool scaled up to %lu workers", pool->live_workers);
+    }
+#endif
+}
+
+/**
+ * @brief Track the backlog and arm the scale-up timer (elastic mode only)
+ *
+ * Called by workers when they dequeue and by submitters in task context.
+ * Workers are created by the timer, never on the submitting task.
+ */
+static void maybe_spawn_worker(struct cf_threadpool_s* pool)
+{
+    if (!pool->elastic) {
+        return;
+    }
+
+    // Cheap unlocked pre-check, repeated below under the critical section
+    bool backlog = (pool->idle_mask == 0 && pool->queued > pool->scale_up_threshold &&
+                    pool->live_workers < pool->thread_count);
+    if (backlog ? (pool->spawning && pool->backlogged) : !pool->backlogged) {
+        return;
+    }
+
+    bool arm = false;
+
+    cf_critical_section_enter();
+    if (!scale_up_needed(pool)) {
+        // The backlog cleared: an armed timer adds nobody
+        pool->backlogged = false;
+    } else if (!pool->spawning) {
+        pool->spawning = true;
+        pool->backlogged = true;
+        arm = true;
+    }
+    cf_critical_section_exit();
+
+    if (arm && cf_timer_start(pool->scale_timer, 0) != CF_OK) {
+        cf_critical_section_enter();
+        pool->backlogged = false;
+        pool->spawning = false;
+        cf_critical_section_exit();
+    }
+}
+
+/**
+ * @brief Weighted round-robin class selection (critical section held)
+ *
+ * Serves each non-empty class up to its weight per round, highest class
+ * first; a new round starts once every non-empty class has used its share.
+ */
+static uint32_t pick_weighted(struct cf_threadpool_s* pool)
+{
+    for (uint32_t round = 0; round < 2; round++) {
+        for (int32_t prio = CF_THREADPOOL_PRIORITY_COUNT - 1; prio >= 0; prio--) {
+            if (pool->class_queued[prio] > 0 && pool->credits[prio] > 0) {
+                pool->credits[prio]--;
+                return (uint32_t)prio;
+            }
+        }
+        memcpy(pool->credits, pool->weights, sizeof(pool->credits));
+    }
+
+    return CF_THREADPOOL_PRIORITY_LOW;
+}
+
+/**
+ * @brief Aging class selection (critical section held)
+ *
+ * Ranks each non-empty class by its base level plus the time its oldest
+ * shared task has waited, one class per aging step. Tasks sitting in
+ * work-stealing deques are drained by their owner and rank at base level.
+ */
+static uint32_t pick_aged(struct cf_threadpool_s* pool)
+{
+    uint32_t now = cf_time_get_tick_count();
+    uint32_t best = CF_THREADPOOL_PRIORITY_LOW;
+    uint32_t best_score = 0;
+    bool any = false;
+
+    for (int32_t prio = CF_THREADPOOL_PRIORITY_COUNT - 1; prio >= 0; prio--) {
+        if (pool->class_queued[prio] == 0) {
+            continue;
+        }
+
+        uint32_t score = (uint32_t)prio * pool->aging_step_ticks;
+        cf_threadpool_deque_t* ring = &pool->queues[prio];
+        if (ring->count > 0) {
+            uint32_t age = now - ring->slots[ring->tail].enqueue_tick;
+            score += CF_MIN(age, UINT32_MAX - score);
+        }
+
+        if (!any || score > best_score) {
+            best = (uint32_t)prio;
+            best_score = score;
+            any = true;
+        }
+    }
+
+    return best;
+}
+
+/**
+ * @brief Choose the class to serve next (critical section held, queued > 0)
+ */
+static uint32_t pick_class(struct cf_threadpool_s* pool)
+{
+    uint32_t top = CF_THREADPOOL_PRIORITY_LOW;
+    for (int32_t prio = CF_THREADPOOL_PRIORITY_COUNT - 1; prio >= 0; prio--) {
+        if (pool->class_queued[prio] > 0) {
+            top = (uint32_t)prio;
+            break;
+        }
+    }
+
+    uint32_t chosen = top;
+    switch (pool->sched_policy) {
+        case CF_THREADPOOL_SCHED_WEIGHTED:
+            chosen = pick_weighted(pool);
+            break;
+        case CF_THREADPOOL_SCHED_AGING:
+            chosen = pick_aged(pool);
+            break;
+        case CF_THREADPOOL_SCHED_STRICT:
+        default:
+            break;
+    }
+
+    // Starvation accounting
+    for (uint32_t prio = 0; prio < CF_THREADPOOL_PRIORITY_COUNT; prio++) {
+        if (prio != chosen && pool->class_queued[prio] > 0) {
+            pool->starved[prio]++;
+        }
+    }
+    if (chosen < top) {
+        pool->promoted[chosen]++;
+    }
+
+    return chosen;
+}
+
+/**
+ * @brief Pop a task of one class (critical section held)
+ *
+ * A work-stealing worker looks at its own deque first, then the shared
+ * ring, then steals from the other workers. Under the aging policy the
+ * shared ring comes first: its oldest task is the one that was ranked.
+ */
+static bool take_from_class(cf_threadpool_worker_t* worker,
+                            uint32_t prio,
+                            cf_threadpool_task_t* task,
+                            bool* wake_submitter)
+{
+    struct cf_threadpool_s* pool = worker->pool;
+    bool local_first = pool->work_stealing && pool->sched_policy != CF_THREADPOOL_SCHED_AGING;
+
+    if (local_first && deque_pop_head(&worker->local[prio], task)) {
+        return true;
+    }
+
+    if (deque_pop_tail(&pool->queues[prio], task)) {
+        *wake_submitter = (pool->space_waiters > 0);
+        return true;
+    }
+
+    if (pool->work_stealing && !local_first && deque_pop_head(&worker->local[prio], task)) {
+        return true;
+    }
+
+    if (pool->work_stealing) {
+        for (uint32_t i = 1; i < pool->thread_count; i++) {
+            uint32_t victim = (worker->id + i) % pool->thread_count;
+            if (deque_pop_tail(&pool->worker_ctx[victim].local[prio], task)) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Try to get next task
+ *
+ * Deadline tasks come first, earliest deadline first; otherwise the class
+ * is chosen by the pool's scheduling policy. Poison pills
+ * (function == NULL) are handed out only when no real task is left.
+ */
+static bool get_next_task(cf_threadpool_worker_t* worker, cf_threadpool_task_t* task)
+{
+    struct cf_threadpool_s* pool = worker->pool;
+    bool found = false;
+    bool wake_submitter = false;
+    bool deadline = false;
+    uint32_t prio = 0;
+
+    if (pool->queued == 0 && pool->exit_pending == 0) {
+        return false;
+    }
+
+    cf_critical_section_enter();
+
+    if (pool->edf_count > 0) {
+        found = deadline = edf_pop(pool, task);
+        wake_submitter = (pool->space_waiters > 0);
+    } else if (pool->queued > 0) {
+        prio = pick_class(pool);
+        found = take_from_class(worker, prio, task, &wake_submitter);
+    }
+
+    if (found) {
+        pool->queued--;
+        if (!deadline) {
+            pool->class_queued[prio]--;
+        }
+        // From here a new submission of the same work queues it again
+        unique_remove(pool, task);
+    } else if (pool->exit_pending > 0) {
+        pool->exit_pending--;
+        memset(task, 0, sizeof(*task));
+        found = true;
+    }
+
+    cf_critical_section_exit();
+
+    // A shared slot freed up while a submitter is blocked on a full ring
+    if (wake_submitter) {
+        cf_semaphore_give(pool->space_sem);
+    }
+
+    return found;
+}
+
+#if CF_THREADPOOL_STACK_CALIBRATION
+/**
+ * @brief Get the lowest address of the calling task's stack
+ */
+static uint32_t* get_stack_base(void)
+{
+#ifdef ESP_PLATFORM
+    return (uint32_t*)pxTaskGetStackStart(NULL);
+#else
+    TaskStatus_t status;
+    vTaskGetInfo(NULL, &status, pdFALSE, eRunning);
+    return (uint32_t*)status.pxStackBase;
+#endif
+}
+
+/**
+ * @brief Paint the free stack below the calling worker before a job
+ *
+ * Only words dirtied since the last paint are written; the painting frame
+ * and CF_THREADPOOL_STACK_GUARD bytes below it are left alone.
+ */
+static void stack_paint(cf_threadpool_worker_t* worker)
+{
+    uint32_t marker = 0;
+    uint32_t* limit = (uint32_t*)(((uintptr_t)&marker - CF_THREADPOOL_STACK_GUARD) & ~(uintptr_t)3);
+
+    for (uint32_t* word = worker->stack_dirty; word < limit; word++) {
+        *word = CF_THREADPOOL_STACK_PAINT;
+    }
+
+    if (limit > worker->stack_dirty) {
+        worker->stack_dirty = limit;
+    }
+}
+
+/**
+ * @brief Measure the stack a job has used since stack_paint()
+ *
+ * @return Bytes from the top of the stack down to the deepest word written
+ */
+static uint32_t stack_measure(struct cf_threadpool_s* pool, cf_threadpool_worker_t* worker)
+{
+    uint32_t* word = worker->stack_base;
+
+    while (word < worker->stack_dirty && *word == CF_THREADPOOL_STACK_PAINT) {
+        word++;
+    }
+    worker->stack_dirty = word;
+
+    return pool->stack_size - (uint32_t)((uintptr_t)word - (uintptr_t)worker->stack_base);
+}
+
+/**
+ * @brief Record the stack use of one run of a job function
+ */
+static void stack_record(struct cf_threadpool_s* pool, cf_threadpool_task_func_t function, uint32_t used)
+{
+    cf_critical_section_enter();
+    uint32_t i = 0;
+    while (i < pool->stack_profile_count && pool->stack_profile[i].function != function) {
+        i++;
+    }
+
+    if (i < CF_THREADPOOL_STACK_PROFILE_SLOTS) {
+        cf_threadpool_stack_profile_t* entry = &pool->stack_profile[i];
+        if (i == pool->stack_profile_count) {
+            entry->function = function;
+            pool->stack_profile_count++;
+        }
+        entry->runs++;
+        if (used > entry->stack_used) {
+            entry->stack_used = used;
+        }
+    }
+    cf_critical_section_exit();
+}
+#endif /* CF_THREADPOOL_STACK_CALIBRATION */
+
+/**
+ * @brief Move the calling worker to another task priority
+ *
+ * Back-to-back jobs of one class, and pools without priority_inherit, make
+ * no kernel call.
+ */
+static void set_worker_priority(cf_threadpool_worker_t* worker, cf_task_priority_t priority)
+{
+    if (worker->priority != priority) {
+        (void)cf_task_set_priority(NULL, priority);
+        worker->priority = priority;
+    }
+}
+
+/**
+ * @brief Park worker until work (or a poison pill) is available
+ *
+ * The idle bit is published in the same critical section that checks for
+ * queued work, so a submission can never slip in between the check and the
+ * wait. A notification sent before the worker blocks is latched by FreeRTOS.
+ *
+ * In elastic mode the wait is bounded by the idle timeout. A worker that
+ * times out while still unclaimed, with the pool above min_threads, gives up
+ * its slot. With CF_STATIC_ALLOCATION workers never retire, since the
+ * static arena cannot take back their stacks for the next scale-up.
+ *
+ * @return Task handle to delete if the worker retires, NULL otherwise
+ */
+static cf_task_t wait_for_work(cf_threadpool_worker_t* worker)
+{
+    struct cf_threadpool_s* pool = worker->pool;
+    uint32_t bit = 1UL << worker->id;
+    bool park = false;
+    cf_task_t retired = NULL;
+
+    cf_critical_section_enter();
+    if (pool->queued == 0 && pool->exit_pending == 0) {
+        pool->idle_mask |= bit;
+        park = true;
+    }
+    cf_critical_section_exit();
+
+    if (!park) {
+        return NULL;
+    }
+
+#if CF_STATIC_ALLOCATION
+    TickType_t ticks = portMAX_DELAY;
+#else
+    TickType_t ticks = pool->elastic ? pool->idle_timeout_ticks : portMAX_DELAY;
+#endif
+    if (ulTaskNotifyTake(pdTRUE, ticks) != 0) {
+        return NULL;
+    }
+
+    cf_critical_section_enter();
+    if ((pool->idle_mask & bit) != 0 && pool->queued == 0 &&
+        pool->live_workers > pool->min_workers &&
+        pool->state == CF_THREADPOOL_RUNNING) {
+        pool->idle_mask &= ~bit;
+        pool->live_workers--;
+        retired = pool->workers[worker->id];
+        pool->workers[worker->id] = NULL;
+        worker->handle = NULL;
+        worker->alive = false;
+    } else {
+        // Staying: a worker that is not parked must not be counted as idle
+        pool->idle_mask &= ~bit;
+    }
+    cf_critical_section_exit();
+
+    return retired;
+}
+
+/**
+ * @brief Worker thread function
+ *
+ * Workers drain the rings in the order set by the scheduling policy
+ * (strictly CRITICAL -> HIGH -> NORMAL -> LOW by default) and park on a task notification when there is nothing left. Submitters
+ * wake exactly as many parked workers as they queued tasks. A worker only
+ * leaves the loop on a poison pill, so it is never stopped mid-task.
+ *
+ * With priority_inherit the worker runs each job at the task priority
+ * mapped from its class and drops back to thread_priority before parking.
+ */
+static void worker_thread(void* arg)
+{
+    cf_threadpool_worker_t* worker = (cf_threadpool_worker_t*)arg;
+    struct cf_threadpool_s* pool = worker->pool;
+    cf_threadpool_task_t task;
+
+    worker->handle = xTaskGetCurrentTaskHandle();
+    worker->priority = pool->thread_priority;
+    worker->stack_free_min = (uint32_t)uxTaskGetStackHighWaterMark(NULL) * sizeof(StackType_t);
+#if CF_THREADPOOL_STACK_CALIBRATION
+    worker->stack_base = get_stack_base();
+    worker->stack_dirty = worker->stack_base;
+#endif
+#if CF_THREADPOOL_TLS_INDEX >= 0
+    vTaskSetThreadLocalStoragePointer(NULL, CF_THREADPOOL_TLS_INDEX, worker);
+#endif
+
+#if CF_LOG_ENABLED
+    CF_LOG_D("ThreadPool worker %lu started", worker->id);
+#endif
+
+    for (;;) {
+        if (!get_next_task(worker, &task)) {
+            // Park at the configured priority
+            set_worker_priority(worker, pool->thread_priority);
+
+#if CF_LOG_ENABLED
+            uint32_t id = worker->id;
+#endif
+            cf_task_t retired = wait_for_work(worker);
+            if (retired != NULL) {
+#if CF_LOG_ENABLED
+                CF_LOG_D("ThreadPool worker %lu retired", id);
+#endif
+                // Slot already released; only locals are used from here
+                cf_task_delete(retired);
+            }
+            continue;
+        }
+
+        // Poison pill
+        if (task.function == NULL) {
+            break;
+        }
+
+        // Taken just before a non-waiting shutdown got to it
+        if (pool->state != CF_THREADPOOL_RUNNING && !pool->draining) {
+            discard_task(pool, &task);
+            continue;
+        }
+
+        // Cancelled while queued: drop without running
+        if (cf_cancel_token_is_cancelled(task.token)) {
+            cf_atomic_fetch_add(&pool->total_cancelled, 1);
+            discard_task(pool, &task);
+            continue;
+        }
+
+        // Already late: drop it if configured (it would finish late anyway)
+        if (task.has_deadline && pool->drop_late &&
+            (int32_t)(cf_time_get_tick_count() - task.deadline) > 0) {
+            cf_atomic_fetch_add(&pool->deadline_missed, 1);
+            cf_atomic_fetch_add(&pool->deadline_dropped, 1);
+            discard_task(pool, &task);
+            continue;
+        }
+
+        maybe_spawn_worker(pool);
+
+        if (pool->priority_inherit) {
+            set_worker_priority(worker, pool->job_priority[get_queue_index(task.priority)]);
+        }
+
+        cf_atomic_fetch_add(&pool->active_tasks, 1);
+        worker->token = task.token;
+
+        void* arg = task.arg;
+#if CF_THREADPOOL_INLINE_ARG_SIZE > 0
+        if (task.payload_size > 0) {
+            arg = task.payload.bytes;
+        }
+#endif
+
+#if CF_THREADPOOL_LATENCY_STATS
+        uint32_t start_cycles = cf_time_get_cycle_count();
+#endif
+
+#if CF_THREADPOOL_STACK_CALIBRATION
+        if (worker->stack_base != NULL) {
+            stack_paint(worker);
+        }
+#endif
+
+        // Execute task
+        task.function(arg);
+        worker->token = NULL;
+
+#if CF_THREADPOOL_STACK_CALIBRATION
+        if (worker->stack_base != NULL) {
+            stack_record(pool, task.function, stack_measure(pool, worker));
+        }
+#endif
+
+        if (worker->scratch_used > 0) {
+            cf_atomic_store_max(&pool->scratch_peak, worker->scratch_used);
+            worker->scratch_used = 0;
+        }
+
+#if CF_THREADPOOL_LATENCY_STATS
+        uint32_t end_cycles = cf_time_get_cycle_count();
+#endif
+
+        // Update statistics
+#if CF_THREADPOOL_LATENCY_STATS
+        record_latency(pool, &task, start_cycles, end_cycles);
+#endif
+        if (task.has_deadline) {
+            record_deadline(pool, &task);
+        }
+        worker->completed++;
+        // Sampled by the worker itself: another task must not read the stack
+        // of a worker that may retire and be freed meanwhile
+        worker->stack_free_min = (uint32_t)uxTaskGetStackHighWaterMark(NULL) * sizeof(StackType_t);
+        cf_atomic_fetch_add(&pool->total_completed, 1);
+        cf_atomic_fetch_sub(&pool->active_tasks, 1);
+        retire_tasks(pool, 1);
+    }
+
+#if CF_LOG_ENABLED
+    CF_LOG_D("ThreadPool worker %lu stopped", worker->id);
+#endif
+
+    // Release the slot, then report to the joiner; after the give the pool
+    // may be freed, so only locals are used
+    cf_semaphore_t exit_sem = pool->exit_sem;
+
+    cf_critical_section_enter();
+    cf_task_t self = pool->workers[worker->id];
+    pool->workers[worker->id] = NULL;
+    worker->handle = NULL;
+    worker->alive = false;
+    pool->live_workers--;
+    cf_critical_section_exit();
+
+    cf_semaphore_give(exit_sem);
+    cf_task_delete(self);
+}
+
+/**
+ * @brief Hand worker-local values to the pool's destructor
+ *
+ * Called once no worker is left to use them.
+ */
+static void release_worker_locals(struct cf_threadpool_s* pool)
+{
+#if CF_THREADPOOL_WORKER_LOCAL_SLOTS > 0
+    for (uint32_t i = 0; pool->local_free != NULL && i < pool->thread_count; i++) {
+        for (uint32_t key = 0; key < CF_THREADPOOL_WORKER_LOCAL_SLOTS; key++) {
+            if (pool->worker_ctx[i].locals[key] != NULL) {
+                pool->local_free(key, pool->worker_ctx[i].locals[key]);
+            }
+        }
+    }
+#else
+    (void)pool;
+#endif
+}
+
+/**
+ * @brief Free worker handles, contexts, work-stealing deques and scratch arenas
+ */
+static void free_worker_contexts(struct cf_threadpool_s* pool)
+{
+    if (pool->worker_ctx != NULL) {
+        cf_free(pool->worker_ctx);
+        pool->worker_ctx = NULL;
+    }
+
+    if (pool->local_slots != NULL) {
+        cf_free(pool->local_slots);
+        pool->local_slots = NULL;
+    }
+
+    if (pool->scratch_mem != NULL) {
+        cf_free(pool->scratch_mem);
+        pool->scratch_mem = NULL;
+    }
+
+    if (pool->workers != NULL) {
+        cf_free(pool->workers);
+        pool->workers = NULL;
+    }
+}
+
+/**
+ * @brief Create worker threads
+ */
+static cf_status_t create_workers(struct cf_threadpool_s* pool, uint32_t initial)
+{
+    uint32_t count = pool->thread_count;
+
+    pool->workers = (cf_task_t*)cf_alloc(count * sizeof(cf_task_t));
+    pool->worker_ctx = (cf_threadpool_worker_t*)cf_alloc(count * sizeof(cf_threadpool_worker_t));
+    if (pool->workers == NULL || pool->worker_ctx == NULL) {
+        free_worker_contexts(pool);
+        return CF_ERROR_NO_MEMORY;
+    }
+
+    memset(pool->workers, 0, count * sizeof(cf_task_t));
+    memset(pool->worker_ctx, 0, count * sizeof(cf_threadpool_worker_t));
+
+    for (uint32_t i = 0; i < count; i++) {
+        pool->worker_ctx[i].pool = pool;
+        pool->worker_ctx[i].id = i;
+    }
+
+    if (pool->work_stealing) {
+        uint32_t local_size = CF_THREADPOOL_LOCAL_QUEUE_SIZE;
+
+        pool->local_slots = (cf_threadpool_task_t*)cf_alloc(
+            count * CF_THREADPOOL_PRIORITY_COUNT * local_size * sizeof(cf_threadpool_task_t));
+        if (pool->local_slots == NULL) {
+            free_worker_contexts(pool);
+            return CF_ERROR_NO_MEMORY;
+        }
+
+        for (uint32_t i = 0; i < count; i++) {
+            for (uint32_t prio = 0; prio < CF_THREADPOOL_PRIORITY_COUNT; prio++) {
+                cf_threadpool_deque_t* dq = &pool->worker_ctx[i].local[prio];
+                dq->slots = &pool->local_slots[(i * CF_THREADPOOL_PRIORITY_COUNT + prio) * local_size];
+                dq->capacity = local_size;
+            }
+        }
+    }
+
+    if (pool->scratch_size > 0) {
+        pool->scratch_mem = (uint8_t*)cf_alloc(count * pool->scratch_size);
+        if (pool->scratch_mem == NULL) {
+            free_worker_contexts(pool);
+            return CF_ERROR_NO_MEMORY;
+        }
+
+        for (uint32_t i = 0; i < count; i++) {
+            pool->worker_ctx[i].scratch = &pool->scratch_mem[i * pool->scratch_size];
+        }
+    }
+
+    for (uint32_t i = 0; i < initial; i++) {
+        pool->worker_ctx[i].alive = true;
+
+        cf_status_t status = spawn_worker(pool, i);
+        if (status != CF_OK) {
+            // Cleanup previously created workers
+            for (uint32_t j = 0; j < i; j++) {
+                cf_task_delete(pool->workers[j]);
+            }
+            free_worker_contexts(pool);
+            return status;
+        }
+    }
+
+    pool->live_workers = initial;
+    pool->peak_workers = initial;
+
+    return CF_OK;
+}
+
+/**
+ * @brief Stop and join worker threads
+ *
+ * New submissions are refused first. With wait_for_tasks the pool then runs
+ * dry (its own workers may still submit follow-up tasks); otherwise queued
+ * tasks are discarded. Finally every worker gets one poison pill and the
+ * caller blocks until each has exited, so running tasks always complete.
+ */
+static void destroy_workers(struct cf_threadpool_s* pool, bool wait_for_tasks)
+{
+    if (pool->workers == NULL) {
+        return;
+    }
+
+    cf_critical_section_enter();
+    pool->state = CF_THREADPOOL_SHUTTING_DOWN;
+    pool->draining = wait_for_tasks;
+    uint32_t space_waiters = pool->space_waiters;
+    cf_critical_section_exit();
+
+    if (!wait_for_tasks) {
+        discard_queued(pool);
+    }
+
+    // Blocked submitters re-check the state and give up
+    while (space_waiters-- > 0) {
+        cf_semaphore_give(pool->space_sem);
+    }
+
+    if (wait_for_tasks) {
+        cf_threadpool_wait_idle_on(pool, CF_WAIT_FOREVER);
+    }
+
+    // Let an armed scale-up timer fire (it adds nobody now) so the worker
+    // count is final and the timer can be deleted
+    while (pool->spawning) {
+        cf_task_delay(1);
+    }
+
+    cf_critical_section_enter();
+    pool->draining = false;
+    uint32_t workers = pool->live_workers;
+    pool->exit_pending = workers;
+    uint32_t wake = claim_idle_workers(pool, workers);
+    cf_critical_section_exit();
+
+    notify_workers(pool, wake);
+
+    // Join: each worker gives exit_sem once, after its last task
+    for (uint32_t i = 0; i < workers; i++) {
+        cf_semaphore_take(pool->exit_sem, CF_WAIT_FOREVER);
+    }
+
+    unregister_pool(pool);
+    release_worker_locals(pool);
+    free_worker_contexts(pool);
+}
+
+/**
+ * @brief Set up an instance in caller-provided storage
+ */
+static cf_status_t pool_init(struct cf_threadpool_s* pool, const cf_threadpool_config_t* config)
+{
+    bool elastic = (config->max_threads > 0);
+    uint32_t slots = elastic ? config->max_threads : config->thread_count;
+    uint32_t initial = elastic ? config->min_threads : config->thread_count;
+
+    if (initial == 0 || config->queue_size == 0 || config->stack_size == 0) {
+        return CF_ERROR_INVALID_PARAM;
+    }
+
+    // One idle bit per worker slot
+    if (slots > 32 || initial > slots) {
+        return CF_ERROR_INVALID_PARAM;
+    }
+
+    if (config->sched_policy > CF_THREADPOOL_SCHED_AGING ||
+        config->deadline_queue_size > UINT16_MAX) {
+        return CF_ERROR_INVALID_PARAM;
+    }
+
+    for (uint32_t prio = 0; prio < CF_THREADPOOL_PRIORITY_COUNT; prio++) {
+        if (config->overload_policy[prio] > CF_THREADPOOL_OVERLOAD_DROP_OLDEST ||
+            (config->priority_inherit && config->job_priority[prio] > CF_TASK_PRIORITY_REALTIME)) {
+            return CF_ERROR_INVALID_PARAM;
+        }
+    }
+
+    memset(pool, 0, sizeof(struct cf_threadpool_s));
+
+#if CF_THREADPOOL_LATENCY_STATS
+    cf_time_cycle_counter_init();
+#endif
+
+    cf_status_t status = CF_OK;
+
+    // Create rings for each priority (NORMAL gets twice the room)
+    uint32_t capacities[CF_THREADPOOL_PRIORITY_COUNT] = {
+        [CF_THREADPOOL_PRIORITY_LOW] = config->queue_size,
+        [CF_THREADPOOL_PRIORITY_NORMAL] = config->queue_size * 2,
+        [CF_THREADPOOL_PRIORITY_HIGH] = config->queue_size,
+        [CF_THREADPOOL_PRIORITY_CRITICAL] = config->queue_size
+    };
+    uint32_t total_slots = config->queue_size * 5;
+
+    pool->queue_slots = (cf_threadpool_task_t*)cf_alloc(total_slots * sizeof(cf_threadpool_task_t));
+    if (pool->queue_slots == NULL) {
+        status = CF_ERROR_NO_MEMORY;
+        goto cleanup;
+    }
+
+    uint32_t offset = 0;
+    for (uint32_t prio = 0; prio < CF_THREADPOOL_PRIORITY_COUNT; prio++) {
+        pool->queues[prio].slots = &pool->queue_slots[offset];
+        pool->queues[prio].capacity = capacities[prio];
+        offset += capacities[prio];
+    }
+
+    // Create deadline heap
+    if (config->deadline_queue_size > 0) {
+        uint32_t capacity = config->deadline_queue_size;
+
+        pool->edf_heap = (cf_threadpool_edf_entry_t*)cf_alloc(capacity * sizeof(cf_threadpool_edf_entry_t));
+        pool->edf_slots = (cf_threadpool_task_t*)cf_alloc(capacity * sizeof(cf_threadpool_task_t));
+        pool->edf_free = (uint16_t*)cf_alloc(capacity * sizeof(uint16_t));
+        if (pool->edf_heap == NULL || pool->edf_slots == NULL || pool->edf_free == NULL) {
+            status = CF_ERROR_NO_MEMORY;
+            goto cleanup;
+        }
+
+        pool->edf_capacity = capacity;
+        edf_clear(pool);
+        total_slots += capacity;
+    }
+    pool->drop_late = config->drop_late;
+
+    // Create key table for coalescing jobs (power of two, a quarter kept free)
+    if (config->unique_slots > 0) {
+        uint32_t size = 4;
+        while (size - size / 4 < config->unique_slots && size < 0x80000000UL) {
+            size <<= 1;
+        }
+
+        pool->unique_table = (cf_threadpool_unique_entry_t*)cf_alloc(size * sizeof(cf_threadpool_unique_entry_t));
+        if (pool->unique_table == NULL) {
+            status = CF_ERROR_NO_MEMORY;
+            goto cleanup;
+        }
+
+        memset(pool->unique_table, 0, size * sizeof(cf_threadpool_unique_entry_t));
+        pool->unique_mask = size - 1;
+    }
+
+    // Create space semaphore (for submitters blocked on a full ring or heap)
+    status = cf_semaphore_create(&pool->space_sem, total_slots, 0);
+    if (status != CF_OK) {
+        goto cleanup;
+    }
+
+    // Create idle semaphore (for wait_idle) and exit semaphore (for shutdown)
+    status = cf_semaphore_create(&pool->idle_sem, UINT16_MAX, 0);
+    if (status != CF_OK) {
+        goto cleanup;
+    }
+
+    status = cf_semaphore_create(&pool->exit_sem, slots, 0);
+    if (status != CF_OK) {
+        goto cleanup;
+    }
+
+    // Save configuration
+    pool->thread_count = slots;
+    pool->stack_size = config->stack_size;
+    pool->thread_priority = config->thread_priority;
+    pool->priority_inherit = config->priority_inherit;
+    memcpy(pool->job_priority, config->job_priority, sizeof(pool->job_priority));
+    strncpy(pool->name, (config->name != NULL) ? config->name : "Worker", sizeof(pool->name) - 1);
+    pool->work_stealing = config->work_stealing;
+    pool->elastic = elastic;
+    pool->min_workers = initial;
+    pool->scale_up_threshold = config->scale_up_threshold;
+    if (elastic) {
+        cf_timer_config_t timer_config;
+        cf_timer_config_default(&timer_config);
+        timer_config.name = "tp_scale";
+        timer_config.period_ms = (config->scale_up_delay_ms > 0) ? config->scale_up_delay_ms : 1;
+        timer_config.type = CF_TIMER_ONE_SHOT;
+        timer_config.callback = scale_up_tick;
+        timer_config.argument = pool;
+
+        status = cf_timer_create(&pool->scale_timer, &timer_config);
+        if (status != CF_OK) {
+            goto cleanup;
+        }
+    }
+    pool->idle_timeout_ticks = pdMS_TO_TICKS(config->idle_timeout_ms);
+    if (pool->idle_timeout_ticks == 0) {
+        pool->idle_timeout_ticks = 1;
+    }
+    pool->sched_policy = config->sched_policy;
+    memcpy(pool->overload, config->overload_policy, sizeof(pool->overload));
+    pool->drop_callback = config->drop_callback;
+    pool->drop_user_data = config->drop_user_data;
+    pool->scratch_size = CF_ALIGN_UP(config->scratch_size, CF_THREADPOOL_SCRATCH_ALIGN);
+    pool->local_free = config->local_free;
+    for (uint32_t prio = 0; prio < CF_THREADPOOL_PRIORITY_COUNT; prio++) {
+        pool->weights[prio] = (config->class_weights[prio] != 0) ?
+                              config->class_weights[prio] : g_default_weights[prio];
+    }
+    memcpy(pool->credits, pool->weights, sizeof(pool->credits));
+    pool->aging_step_ticks = pdMS_TO_TICKS((config->aging_step_ms != 0) ?
+                                           config->aging_step_ms : CF_THREADPOOL_AGING_STEP_MS);
+    if (pool->aging_step_ticks == 0) {
+        pool->aging_step_ticks = 1;
+    }
+    pool->state = CF_THREADPOOL_RUNNING;
+
+    // Create worker threads
+    status = create_workers(pool, initial);
+    if (status != CF_OK) {
+        goto cleanup;
+    }
+
+    register_pool(pool);
+    pool->initialized = true;
+
+#if CF_LOG_ENABLED
+    CF_LOG_I("ThreadPool initialized: %lu workers (max %lu), queue size %lu",
+             initial, slots, config->queue_size);
+#endif
+
+    return CF_OK;
+
+cleanup:
+    if (pool->scale_timer) cf_timer_delete(pool->scale_timer, CF_WAIT_FOREVER);
+    if (pool->space_sem) cf_semaphore_destroy(pool->space_sem);
+    if (pool->idle_sem) cf_semaphore_destroy(pool->idle_sem);
+    if (pool->exit_sem) cf_semaphore_destroy(pool->exit_sem);
+    if (pool->queue_slots) cf_free(pool->queue_slots);
+    if (pool->edf_heap) cf_free(pool->edf_heap);
+    if (pool->edf_slots) cf_free(pool->edf_slots);
+    if (pool->edf_free) cf_free(pool->edf_free);
+    if (pool->unique_table) cf_free(pool->unique_table);
+
+    memset(pool, 0, sizeof(struct cf_threadpool_s));
+    return status;
+}
+
+/**
+ * @brief Tear down an instance (the storage itself is not freed)
+ */
+static void pool_deinit(struct cf_threadpool_s* pool, bool wait_for_tasks)
+{
+    // No more delayed jobs for this pool
+    cf_threadpool_timer_cancel_all(pool);
+
+    // Stop and join workers
+    destroy_workers(pool, wait_for_tasks);
+
+    // Destroy rings and deadline heap
+    cf_free(pool->queue_slots);
+    pool->queue_slots = NULL;
+    if (pool->edf_capacity > 0) {
+        cf_free(pool->edf_heap);
+        cf_free(pool->edf_slots);
+        cf_free(pool->edf_free);
+        pool->edf_heap = NULL;
+        pool->edf_slots = NULL;
+        pool->edf_free = NULL;
+        pool->edf_capacity = 0;
+    }
+    cf_free(pool->unique_table);
+    pool->unique_table = NULL;
+
+    // Destroy the scale-up timer (disarmed: destroy_workers() waited for it)
+    if (pool->scale_timer != NULL) {
+        cf_timer_delete(pool->scale_timer, CF_WAIT_FOREVER);
+        pool->scale_timer = NULL;
+    }
+
+    // Destroy semaphores
+    cf_semaphore_destroy(pool->space_sem);
+    cf_semaphore_destroy(pool->idle_sem);
+    cf_semaphore_destroy(pool->exit_sem);
+
+    pool->initialized = false;
+    pool->state = CF_THREADPOOL_STOPPED;
+
+#if CF_LOG_ENABLED
+    CF_LOG_I("ThreadPool deinitialized (completed %lu tasks)",
+             cf_atomic_load(&pool->total_completed));
+#endif
+}
+
+/**
+ * @brief Enqueue a run of jobs under one critical section
+ *
+ * Stops at the first job whose ring is full so that acceptance is always a
+ * prefix of the array. Parked workers are claimed for the accepted jobs.
+ * A coalescing job whose key is already queued is accepted without
+ * queueing anything.
+ * Under CF_THREADPOOL_OVERLOAD_DROP_OLDEST one queued task may be evicted
+ * to make room; the caller hands it to the drop callback.
+ *
+ * @param[in] stamp Submission timestamp (cf_time_get_cycle_count())
+ * @param[in] tick Submission tick (cf_time_get_tick_count())
+ * @param[out] wake Mask of workers to notify once out of the critical section
+ * @param[in] wait_space Register as a space waiter if the run stops early
+ *                       on a class with the BLOCK overload policy
+ * @param[out] evicted Receives the evicted task (function NULL if none)
+ *
+ * @return Number of jobs accepted
+ */
+static size_t enqueue_jobs(struct cf_threadpool_s* pool,
+                           cf_threadpool_worker_t* self,
+                           const cf_threadpool_job_t* jobs,
+                           size_t n,
+                           uint32_t stamp,
+                           uint32_t tick,
+                           uint32_t* wake,
+                           bool wait_space,
+                           cf_threadpool_task_t* evicted)
+{
+    size_t accepted = 0;
+    uint32_t replaced = 0;
+    uint32_t merged = 0;
+
+    while (accepted < n) {
+        cf_threadpool_task_t task = {
+            .function = jobs[accepted].function,
+            .arg = jobs[accepted].arg,
+            .priority = jobs[accepted].priority,
+            .token = jobs[accepted].token,
+            .tag = jobs[accepted].tag,
+            .enqueue_tick = tick,
+            .has_deadline = jobs[accepted].has_deadline,
+            .deadline = jobs[accepted].deadline,
+            .key = jobs[accepted].key,
+            .discard = jobs[accepted].discard
+        };
+#if CF_THREADPOOL_LATENCY_STATS
+        task.submit_cycles = stamp;
+#else
+        (void)stamp;
+#endif
+#if CF_THREADPOOL_INLINE_ARG_SIZE > 0
+        if (jobs[accepted].data_size > 0) {
+            memcpy(task.payload.bytes, jobs[accepted].data, jobs[accepted].data_size);
+            task.payload_size = (uint8_t)jobs[accepted].data_size;
+        }
+#endif
+
+        if (jobs[accepted].coalesce) {
+            uint32_t slot = unique_probe(pool, task.function, task.key);
+            if (pool->unique_table[slot].function != NULL) {
+                merged++;
+                accepted++;
+                continue;
+            }
+            task.unique = unique_insert(pool, &task);
+        }
+
+        if (!enqueue_task(pool, self, &task)) {
+            cf_threadpool_overload_policy_t policy = pool->overload[get_queue_index(task.priority)];
+
+            // One eviction per call, as the drop callback runs outside
+            if (policy == CF_THREADPOOL_OVERLOAD_DROP_OLDEST && replaced == 0 &&
+                evict_oldest(pool, &task, evicted) && enqueue_task(pool, self, &task)) {
+                replaced = 1;
+                accepted++;
+                continue;
+            }
+
+            unique_remove(pool, &task);
+
+            if (wait_space && policy == CF_THREADPOOL_OVERLOAD_BLOCK) {
+                pool->space_waiters++;
+            }
+            break;
+        }
+
+        accepted++;
+    }
+
+    // An evicted task stops being outstanding as its replacement starts;
+    // netting the two keeps outstanding from touching 0 in between
+    cf_atomic_fetch_add(&pool->outstanding, (uint32_t)accepted - merged - replaced);
+    cf_atomic_fetch_add(&pool->total_submitted, (uint32_t)accepted - merged);
+    if (merged > 0) {
+        cf_atomic_fetch_add(&pool->coalesced, merged);
+    }
+    *wake = claim_idle_workers(pool, (uint32_t)accepted - merged);
+
+    return accepted;
+}
+
+/**
+ * @brief Report a task evicted by DROP_OLDEST to the drop callback
+ *
+ * Already retired by enqueue_jobs(), so this is ISR-safe as long as the
+ * callback is.
+ */
+static void release_evicted(struct cf_threadpool_s* pool, const cf_threadpool_task_t* task)
+{
+    cf_atomic_fetch_add(&pool->overload_dropped[get_queue_index(task->priority)], 1);
+
+    if (pool->drop_callback == NULL) {
+        return;
+    }
+
+    cf_threadpool_job_t job = {
+        .function = task->function,
+        .arg = task->arg,
+        .priority = task->priority,
+        .token = task->token,
+        .tag = task->tag,
+        .has_deadline = task->has_deadline,
+        .deadline = task->deadline,
+        .coalesce = task->unique,
+        .key = task->key
+    };
+#if CF_THREADPOOL_INLINE_ARG_SIZE > 0
+    if (task->payload_size > 0) {
+        job.data = task->payload.bytes;
+        job.data_size = task->payload_size;
+    }
+#endif
+
+    pool->drop_callback(&job, pool->drop_user_data);
+}
+
+/**
+ * @brief Run a job on the submitting task (CALLER_RUNS overload policy)
+ */
+static void run_inline(struct cf_threadpool_s* pool, const cf_threadpool_job_t* job)
+{
+    cf_atomic_fetch_add(&pool->overload_caller_runs[get_queue_index(job->priority)], 1);
+
+    void* arg = job->arg;
+#if CF_THREADPOOL_INLINE_ARG_SIZE > 0
+    // Same contract as a queued job: the task gets its own copy
+    union {
+        uint8_t bytes[CF_THREADPOOL_INLINE_ARG_SIZE];
+        uint64_t align_u64;
+        void* align_ptr;
+    } payload;
+    if (job->data_size > 0) {
+        memcpy(payload.bytes, job->data, job->data_size);
+        arg = payload.bytes;
+    }
+#endif
+
+    if (cf_cancel_token_is_cancelled(job->token)) {
+        cf_atomic_fetch_add(&pool->total_cancelled, 1);
+        if (job->discard != NULL) {
+            job->discard(arg);
+        }
+        return;
+    }
+
+    job->function(arg);
+}
+
+/**
+ * @brief Submit jobs from task context, applying the overload policies
+ */
+static cf_status_t submit_jobs(struct cf_threadpool_s* pool,
+                               const cf_threadpool_job_t* jobs,
+                               size_t n,
+                               uint32_t timeout_ms,
+                               size_t* accepted)
+{
+    cf_threadpool_worker_t* self = find_current_worker(pool);
+    uint32_t start_tick = cf_time_get_tick_count();
+    size_t done = 0;
+    size_t waited = n;          /**< Job counted in overload_blocked already */
+    cf_status_t status = CF_OK;
+
+    while (done < n) {
+        uint32_t wake = 0;
+        bool wait_space = (timeout_ms != 0);
+        uint32_t stamp = cf_time_get_cycle_count();
+        uint32_t tick = cf_time_get_tick_count();
+        cf_threadpool_task_t evicted;
+
+        evicted.function = NULL;
+
+        cf_critical_section_enter();
+        if (!accepts_jobs(pool, self)) {
+            cf_critical_section_exit();
+            status = CF_ERROR_INVALID_STATE;
+            break;
+        }
+        size_t count = enqueue_jobs(pool, self, &jobs[done], n - done, stamp, tick,
+                                    &wake, wait_space, &evicted);
+        cf_critical_section_exit();
+
+        notify_workers(pool, wake);
+        maybe_spawn_worker(pool);
+        done += count;
+
+        if (evicted.function != NULL) {
+            release_evicted(pool, &evicted);
+        }
+
+        if (done == n) {
+            break;
+        }
+
+        // jobs[done] found its queue full
+        uint32_t index = get_queue_index(jobs[done].priority);
+        cf_threadpool_overload_policy_t policy = pool->overload[index];
+
+        if (policy == CF_THREADPOOL_OVERLOAD_DROP_OLDEST && evicted.function != NULL) {
+            continue;
+        }
+
+        if (policy == CF_THREADPOOL_OVERLOAD_CALLER_RUNS && !jobs[done].no_caller_runs) {
+            run_inline(pool, &jobs[done]);
+            done++;
+            continue;
+        }
+
+        if (policy != CF_THREADPOOL_OVERLOAD_BLOCK || !wait_space) {
+            cf_atomic_fetch_add(&pool->overload_rejected[index], 1);
+            status = CF_ERROR_QUEUE_FULL;
+            break;
+        }
+
+        if (waited != done) {
+            cf_atomic_fetch_add(&pool->overload_blocked[index], 1);
+            waited = done;
+        }
+
+        // Block until a worker frees a slot (or the timeout expires)
+        uint32_t remaining = CF_WAIT_FOREVER;
+        if (timeout_ms != CF_WAIT_FOREVER) {
+            uint32_t elapsed = cf_time_elapsed_ms(start_tick);
+            remaining = (elapsed < timeout_ms) ? (timeout_ms - elapsed) : 0;
+        }
+
+        status = cf_semaphore_take(pool->space_sem, remaining);
+
+        cf_critical_section_enter();
+        pool->space_waiters--;
+        cf_critical_section_exit();
+
+        if (status != CF_OK) {
+            cf_atomic_fetch_add(&pool->overload_rejected[index], 1);
+            status = CF_ERROR_TIMEOUT;
+            break;
+        }
+    }
+
+    if (accepted != NULL) {
+        *accepted = done;
+    }
+
+    return (done == n) ? CF_OK : status;
+}
+
+/**
+ * @brief Submit jobs from ISR context (never waits)
+ */
+static cf_status_t submit_jobs_from_isr(struct cf_threadpool_s* pool,
+                                        const cf_threadpool_job_t* jobs,
+                                        size_t n,
+                                        size_t* accepted,
+                                        BaseType_t* pxHigherPriorityTaskWoken)
+{
+    size_t done = 0;
+    cf_status_t status = CF_OK;
+    uint32_t stamp = cf_time_get_cycle_count_from_isr();
+    uint32_t tick = cf_time_get_tick_count_from_isr();
     BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-    BaseType_t result = xQueueSendFromISR(q->handle, &task, &xHigherPriorityTaskWoken);
 
-    if (pxHigherPriorityTaskWoken != NULL) {
-        *pxHigherPriorityTaskWoken = xHigherPriorityTaskWoken;
+    // Only DROP_OLDEST gets past a full queue here: there is no waiting,
+    // and an ISR cannot run the job itself
+    while (done < n) {
+        uint32_t wake = 0;
+        cf_threadpool_task_t evicted;
+
+        evicted.function = NULL;
+
+        cf_critical_state_t state = cf_critical_section_enter_from_isr();
+        if (pool->state != CF_THREADPOOL_RUNNING) {
+            cf_critical_section_exit_from_isr(state);
+            status = CF_ERROR_INVALID_STATE;
+            break;
+        }
+        done += enqueue_jobs(pool, NULL, &jobs[done], n - done, stamp, tick, &wake, false, &evicted);
+        cf_critical_section_exit_from_isr(state);
+
+        notify_workers_from_isr(pool, wake, &xHigherPriorityTaskWoken);
+
+        if (evicted.function == NULL) {
+            break;
+        }
+        release_evicted(pool, &evicted);
+    }
+
+    if (status == CF_OK && done < n) {
+        cf_atomic_fetch_add(&pool->overload_rejected[get_queue_index(jobs[done].priority)], 1);
+        status = CF_ERROR_QUEUE_FULL;
+    }
+
+    if (pxHigherPriorityTaskWoken != NULL) {
+        *pxHigherPriorityTaskWoken = xHigherPriorityTaskWoken;
+    }
+
+    if (accepted != NULL) {
+        *accepted = done;
+    }
+
+    return status;
+}
+
+/**
+ * @brief Validate and submit a single job from ISR context
+ */
+static cf_status_t submit_job_from_isr(cf_threadpool_t pool,
+                                       const cf_threadpool_job_t* job,
+                                       BaseType_t* pxHigherPriorityTaskWoken)
+{
+    struct cf_threadpool_s* p = resolve_pool(pool);
+
+    if (!p->initialized) {
+        return CF_ERROR_NOT_INITIALIZED;
+    }
+
+    if (p->state != CF_THREADPOOL_RUNNING) {
+        return CF_ERROR_INVALID_STATE;
+    }
+
+    cf_status_t status = check_job(p, job);
+    if (status != CF_OK) {
+        return status;
+    }
+
+    return submit_jobs_from_isr(p, job, 1, NULL, pxHigherPriorityTaskWoken);
+}
+
+//==============================================================================
+// PUBLIC API IMPLEMENTATION - INSTANCES
+//==============================================================================
+
+cf_status_t cf_threadpool_create(cf_threadpool_t* pool, const cf_threadpool_config_t* config)
+{
+    CF_PTR_CHECK(pool);
+    CF_PTR_CHECK(config);
+
+    // Allocate pool structure
+    struct cf_threadpool_s* p = (struct cf_threadpool_s*)cf_alloc(sizeof(struct cf_threadpool_s));
+    if (p == NULL) {
+        return CF_ERROR_NO_MEMORY;
+    }
+
+    cf_status_t status = pool_init(p, config);
+    if (status != CF_OK) {
+        cf_free(p);
+        return status;
+    }
+
+    *pool = p;
+    return CF_OK;
+}
+
+void cf_threadpool_destroy(cf_threadpool_t pool, bool wait_for_tasks)
+{
+    if (pool == NULL || pool == &g_default_pool || !pool->initialized) {
+        return;
+    }
+
+    pool_deinit(pool, wait_for_tasks);
+    cf_free(pool);
+}
+
+cf_threadpool_t cf_threadpool_get_default(void)
+{
+    return g_default_pool.initialized ? &g_default_pool : NULL;
+}
+
+cf_status_t cf_threadpool_submit_to(cf_threadpool_t pool,
+                                     cf_threadpool_task_func_t function,
+                                     void* arg,
+                                     cf_threadpool_priority_t priority,
+                                     uint32_t timeout_ms)
+{
+    cf_threadpool_job_t job = {
+        .function = function,
+        .arg = arg,
+        .priority = priority
+    };
+
+    return cf_threadpool_submit_job(pool, &job, timeout_ms);
+}
+
+cf_status_t cf_threadpool_submit_job(cf_threadpool_t pool,
+                                      const cf_threadpool_job_t* job,
+                                      uint32_t timeout_ms)
+{
+    CF_PTR_CHECK(job);
+
+    struct cf_threadpool_s* p = resolve_pool(pool);
+
+    if (!p->initialized) {
+        return CF_ERROR_NOT_INITIALIZED;
+    }
+
+    cf_status_t status = check_job(p, job);
+    if (status != CF_OK) {
+        return status;
+    }
+
+    return submit_jobs(p, job, 1, timeout_ms, NULL);
+}
+
+cf_status_t cf_threadpool_submit_to_from_isr(cf_threadpool_t pool,
+                                              cf_threadpool_task_func_t function,
+                                              void* arg,
+                                              cf_threadpool_priority_t priority,
+                                              BaseType_t* pxHigherPriorityTaskWoken)
+{
+    cf_threadpool_job_t job = {
+        .function = function,
+        .arg = arg,
+        .priority = priority
+    };
+
+    return submit_job_from_isr(pool, &job, pxHigherPriorityTaskWoken);
+}
+
+cf_status_t cf_threadpool_submit_deadline_to(cf_threadpool_t pool,
+                                              cf_threadpool_task_func_t function,
+                                              void* arg,
+                                              uint32_t deadline_tick,
+                                              uint32_t timeout_ms)
+{
+    cf_threadpool_job_t job = {
+        .function = function,
+        .arg = arg,
+        .priority = CF_THREADPOOL_PRIORITY_NORMAL,
+        .has_deadline = true,
+        .deadline = deadline_tick
+    };
+
+    return cf_threadpool_submit_job(pool, &job, timeout_ms);
+}
+
+cf_status_t cf_threadpool_submit_unique_to(cf_threadpool_t pool,
+                                            cf_threadpool_task_func_t function,
+                                            void* arg,
+                                            uintptr_t key,
+                                            cf_threadpool_priority_t priority,
+                                            uint32_t timeout_ms)
+{
+    cf_threadpool_job_t job = {
+        .function = function,
+        .arg = arg,
+        .priority = priority,
+        .coalesce = true,
+        .key = key
+    };
+
+    return cf_threadpool_submit_job(pool, &job, timeout_ms);
+}
+
+cf_status_t cf_threadpool_submit_copy_to(cf_threadpool_t pool,
+                                          cf_threadpool_task_func_t function,
+                                          const void* data,
+                                          size_t size,
+                                          cf_threadpool_priority_t priority,
+                                          uint32_t timeout_ms)
+{
+    CF_PTR_CHECK(data);
+
+    if (size == 0) {
+        return CF_ERROR_INVALID_PARAM;
+    }
+
+    cf_threadpool_job_t job = {
+        .function = function,
+        .priority = priority,
+        .data = data,
+        .data_size = size
+    };
+
+    return cf_threadpool_submit_job(pool, &job, timeout_ms);
+}
+
+cf_status_t cf_threadpool_submit_copy_to_from_isr(cf_threadpool_t pool,
+                                                   cf_threadpool_task_func_t function,
+                                                   const void* data,
+                                                   size_t size,
+                                                   cf_threadpool_priority_t priority,
+                                                   BaseType_t* pxHigherPriorityTaskWoken)
+{
+    CF_PTR_CHECK(data);
+
+    if (size == 0) {
+        return CF_ERROR_INVALID_PARAM;
+    }
+
+    cf_threadpool_job_t job = {
+        .function = function,
+        .priority = priority,
+        .data = data,
+        .data_size = size
+    };
+
+    return submit_job_from_isr(pool, &job, pxHigherPriorityTaskWoken);
+}
+
+cf_status_t cf_threadpool_submit_batch_to(cf_threadpool_t pool,
+                                           const cf_threadpool_job_t* jobs,
+                                           size_t n,
+                                           uint32_t timeout_ms,
+                                           size_t* accepted)
+{
+    if (accepted != NULL) {
+        *accepted = 0;
+    }
+
+    CF_PTR_CHECK(jobs);
+
+    struct cf_threadpool_s* p = resolve_pool(pool);
+
+    if (!p->initialized) {
+        return CF_ERROR_NOT_INITIALIZED;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        cf_status_t status = check_job(p, &jobs[i]);
+        if (status != CF_OK) {
+            return status;
+        }
+    }
+
+    return submit_jobs(p, jobs, n, timeout_ms, accepted);
+}
+
+cf_status_t cf_threadpool_submit_batch_to_from_isr(cf_threadpool_t pool,
+                                                    const cf_threadpool_job_t* jobs,
+                                                    size_t n,
+                                                    size_t* accepted,
+                                                    BaseType_t* pxHigherPriorityTaskWoken)
+{
+    if (accepted != NULL) {
+        *accepted = 0;
+    }
+
+    CF_PTR_CHECK(jobs);
+
+    struct cf_threadpool_s* p = resolve_pool(pool);
+
+    if (!p->initialized) {
+        return CF_ERROR_NOT_INITIALIZED;
+    }
+
+    if (p->state != CF_THREADPOOL_RUNNING) {
+        return CF_ERROR_INVALID_STATE;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        cf_status_t status = check_job(p, &jobs[i]);
+        if (status != CF_OK) {
+            return status;
+        }
     }
 
-    if (result != pdTRUE) {
-        return CF_ERROR_QUEUE_FULL;
+    return submit_jobs_from_isr(p, jobs, n, accepted, pxHigherPriorityTaskWoken);
+}
+
+cf_status_t cf_threadpool_get_stats(cf_threadpool_t pool, cf_threadpool_stats_t* stats)
+{
+    CF_PTR_CHECK(stats);
+
+    struct cf_threadpool_s* p = resolve_pool(pool);
+
+    memset(stats, 0, sizeof(cf_threadpool_stats_t));
+
+    if (!p->initialized) {
+        return CF_ERROR_NOT_INITIALIZED;
     }
 
-    // Note: Cannot update statistics in ISR (mutex not allowed)
+    // Each field is read individually; the snapshot is not a single instant
+    stats->active_tasks = cf_atomic_load(&p->active_tasks);
+    stats->total_completed = cf_atomic_load(&p->total_completed);
+    stats->total_submitted = cf_atomic_load(&p->total_submitted);
+    stats->total_cancelled = cf_atomic_load(&p->total_cancelled);
+    for (uint32_t prio = 0; prio < CF_THREADPOOL_PRIORITY_COUNT; prio++) {
+        stats->starved[prio] = p->starved[prio];
+        stats->promoted[prio] = p->promoted[prio];
+        stats->overload_blocked[prio] = cf_atomic_load(&p->overload_blocked[prio]);
+        stats->overload_rejected[prio] = cf_atomic_load(&p->overload_rejected[prio]);
+        stats->overload_caller_runs[prio] = cf_atomic_load(&p->overload_caller_runs[prio]);
+        stats->overload_dropped[prio] = cf_atomic_load(&p->overload_dropped[prio]);
+    }
+    stats->scratch_peak = cf_atomic_load(&p->scratch_peak);
+    stats->scratch_failures = cf_atomic_load(&p->scratch_failures);
+    stats->coalesced = cf_atomic_load(&p->coalesced);
+    stats->deadline_met = cf_atomic_load(&p->deadline_met);
+    stats->deadline_missed = cf_atomic_load(&p->deadline_missed);
+    stats->deadline_dropped = cf_atomic_load(&p->deadline_dropped);
+    stats->deadline_max_lateness_ms = cf_time_ticks_to_ms(cf_atomic_load(&p->deadline_max_lateness));
+    stats->pending_tasks = p->queued;
+    stats->thread_count = p->live_workers;
+    stats->peak_thread_count = p->peak_workers;
+    stats->state = p->state;
 
     return CF_OK;
 }
 
-uint32_t cf_threadpool_get_active_count(void)
+cf_status_t cf_threadpool_get_worker_stats(cf_threadpool_t pool,
+                                           cf_threadpool_worker_stats_t* stats,
+                                           size_t max,
+                                           size_t* count)
 {
-    if (!g_threadpool.initialized) {
-        return 0;
+    if (count != NULL) {
+        *count = 0;
+    }
+
+    CF_PTR_CHECK(stats);
+
+    struct cf_threadpool_s* p = resolve_pool(pool);
+
+    if (!p->initialized) {
+        return CF_ERROR_NOT_INITIALIZED;
     }
 
-    cf_mutex_lock(g_threadpool.mutex, CF_WAIT_FOREVER);
-    uint32_t count = g_threadpool.active_tasks;
-    cf_mutex_unlock(g_threadpool.mutex);
+    size_t n = CF_MIN(max, (size_t)p->thread_count);
 
-    return count;
+    for (size_t i = 0; i < n; i++) {
+        cf_threadpool_worker_t* worker = &p->worker_ctx[i];
+
+        stats[i].stack_size = p->stack_size;
+        stats[i].tasks_completed = worker->completed;
+
+        cf_critical_section_enter();
+        stats[i].alive = (worker->handle != NULL);
+        stats[i].stack_free_min = stats[i].alive ? worker->stack_free_min : 0;
+        cf_critical_section_exit();
+    }
+
+    if (count != NULL) {
+        *count = n;
+    }
+
+    return CF_OK;
 }
 
-uint32_t cf_threadpool_get_pending_count(void)
+cf_status_t cf_threadpool_get_stack_profile(cf_threadpool_t pool,
+                                            cf_threadpool_stack_profile_t* profile,
+                                            size_t max,
+                                            size_t* count)
 {
-    if (!g_threadpool.initialized) {
-        return 0;
+    if (count != NULL) {
+        *count = 0;
+    }
+
+    CF_PTR_CHECK(profile);
+
+#if CF_THREADPOOL_STACK_CALIBRATION
+    struct cf_threadpool_s* p = resolve_pool(pool);
+
+    if (!p->initialized) {
+        return CF_ERROR_NOT_INITIALIZED;
+    }
+
+    cf_critical_section_enter();
+    size_t n = CF_MIN(max, (size_t)p->stack_profile_count);
+    memcpy(profile, p->stack_profile, n * sizeof(cf_threadpool_stack_profile_t));
+    cf_critical_section_exit();
+
+    if (count != NULL) {
+        *count = n;
     }
 
-    return cf_queue_get_count(g_threadpool.queue_critical) +
-           cf_queue_get_count(g_threadpool.queue_high) +
-           cf_queue_get_count(g_threadpool.queue_normal) +
-           cf_queue_get_count(g_threadpool.queue_low);
+    return CF_OK;
+#else
+    (void)pool;
+    (void)max;
+    return CF_ERROR_NOT_SUPPORTED;
+#endif
 }
 
-bool cf_threadpool_is_idle(void)
+cf_status_t cf_threadpool_get_latency_stats(cf_threadpool_t pool, cf_threadpool_latency_stats_t* stats)
+{
+    CF_PTR_CHECK(stats);
+
+#if CF_THREADPOOL_LATENCY_STATS
+    struct cf_threadpool_s* p = resolve_pool(pool);
+
+    if (!p->initialized) {
+        return CF_ERROR_NOT_INITIALIZED;
+    }
+
+    for (uint32_t prio = 0; prio < CF_THREADPOOL_PRIORITY_COUNT; prio++) {
+        cf_threadpool_latency_counters_t* src = &p->latency[prio];
+        cf_threadpool_class_latency_t* dst = &stats->classes[prio];
+
+        dst->count = cf_atomic_load(&src->count);
+        dst->wait_max_us = cf_atomic_load(&src->wait_max_us);
+        dst->run_max_us = cf_atomic_load(&src->run_max_us);
+        for (uint32_t b = 0; b < CF_THREADPOOL_LATENCY_BUCKETS; b++) {
+            dst->wait_hist[b] = cf_atomic_load(&src->wait_hist[b]);
+            dst->run_hist[b] = cf_atomic_load(&src->run_hist[b]);
+        }
+    }
+
+    return CF_OK;
+#else
+    (void)pool;
+    return CF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+cf_status_t cf_threadpool_reset_latency_stats(cf_threadpool_t pool)
 {
-    return cf_threadpool_get_active_count() == 0 &&
-           cf_threadpool_get_pending_count() == 0;
+#if CF_THREADPOOL_LATENCY_STATS
+    struct cf_threadpool_s* p = resolve_pool(pool);
+
+    if (!p->initialized) {
+        return CF_ERROR_NOT_INITIALIZED;
+    }
+
+    for (uint32_t prio = 0; prio < CF_THREADPOOL_PRIORITY_COUNT; prio++) {
+        cf_threadpool_latency_counters_t* cls = &p->latency[prio];
+
+        cf_atomic_store(&cls->count, 0);
+        cf_atomic_store(&cls->wait_max_us, 0);
+        cf_atomic_store(&cls->run_max_us, 0);
+        for (uint32_t b = 0; b < CF_THREADPOOL_LATENCY_BUCKETS; b++) {
+            cf_atomic_store(&cls->wait_hist[b], 0);
+            cf_atomic_store(&cls->run_hist[b], 0);
+        }
+    }
+
+    return CF_OK;
+#else
+    (void)pool;
+    return CF_ERROR_NOT_SUPPORTED;
+#endif
 }
 
-cf_threadpool_state_t cf_threadpool_get_state(void)
+uint32_t cf_threadpool_latency_percentile(const uint32_t hist[CF_THREADPOOL_LATENCY_BUCKETS],
+                                          uint32_t percent)
 {
-    return g_threadpool.state;
+    uint64_t total = 0;
+
+    if (hist == NULL) {
+        return 0;
+    }
+
+    for (uint32_t b = 0; b < CF_THREADPOOL_LATENCY_BUCKETS; b++) {
+        total += hist[b];
+    }
+
+    if (total == 0) {
+        return 0;
+    }
+
+    // Rank of the sample at the requested percentile (rounded up, at least 1)
+    uint64_t rank = (total * CF_MIN(percent, 100U) + 99U) / 100U;
+    if (rank == 0) {
+        rank = 1;
+    }
+
+    uint64_t seen = 0;
+    for (uint32_t b = 0; b < CF_THREADPOOL_LATENCY_BUCKETS - 1; b++) {
+        seen += hist[b];
+        if (seen >= rank) {
+            return 1UL << b;
+        }
+    }
+
+    return UINT32_MAX;
 }
 
-cf_status_t cf_threadpool_wait_idle(uint32_t timeout_ms)
+cf_status_t cf_threadpool_wait_idle_on(cf_threadpool_t pool, uint32_t timeout_ms)
 {
-    if (!g_threadpool.initialized) {
+    struct cf_threadpool_s* p = resolve_pool(pool);
+
+    if (!p->initialized) {
         return CF_ERROR_NOT_INITIALIZED;
     }
 
-    uint32_t elapsed = 0;
-    uint32_t check_interval = 10; // Check every 10ms
+    uint32_t start_tick = cf_time_get_tick_count();
 
-    while (!cf_threadpool_is_idle()) {
-        if (timeout_ms != CF_WAIT_FOREVER && elapsed >= timeout_ms) {
+    for (;;) {
+        uint32_t remaining = CF_WAIT_FOREVER;
+        if (timeout_ms != CF_WAIT_FOREVER) {
+            uint32_t elapsed = cf_time_elapsed_ms(start_tick);
+            remaining = (elapsed < timeout_ms) ? (timeout_ms - elapsed) : 0;
+        }
+
+        // Checked and registered atomically against retire_tasks()
+        cf_critical_section_enter();
+        if (cf_atomic_load(&p->outstanding) == 0) {
+            cf_critical_section_exit();
+            return CF_OK;
+        }
+        if (remaining == 0) {
+            cf_critical_section_exit();
             return CF_ERROR_TIMEOUT;
         }
+        p->idle_waiters++;
+        uint32_t generation = p->idle_generation;
+        cf_critical_section_exit();
+
+        if (cf_semaphore_take(p->idle_sem, remaining) != CF_OK) {
+            // Still registered unless released in the meantime (the token
+            // then left behind only causes a spurious wakeup later)
+            cf_critical_section_enter();
+            if (p->idle_generation == generation) {
+                p->idle_waiters--;
+            }
+            cf_critical_section_exit();
+        }
+    }
+}
+
+//==============================================================================
+// PUBLIC API IMPLEMENTATION - CANCELLATION
+//==============================================================================
+
+void cf_cancel_token_init(cf_cancel_token_t* token)
+{
+    if (token != NULL) {
+        cf_atomic_store(&token->cancelled, 0);
+    }
+}
+
+void cf_cancel_token_cancel(cf_cancel_token_t* token)
+{
+    if (token != NULL) {
+        cf_atomic_store(&token->cancelled, 1);
+    }
+}
+
+void cf_cancel_token_reset(cf_cancel_token_t* token)
+{
+    if (token != NULL) {
+        cf_atomic_store(&token->cancelled, 0);
+    }
+}
+
+bool cf_cancel_token_is_cancelled(const cf_cancel_token_t* token)
+{
+    return token != NULL && cf_atomic_load(&((cf_cancel_token_t*)token)->cancelled) != 0;
+}
+
+bool cf_cancel_requested(void)
+{
+    cf_threadpool_worker_t* self = current_worker();
+
+    return self != NULL && cf_cancel_token_is_cancelled(self->token);
+}
+
+cf_status_t cf_threadpool_cancel_tagged(cf_threadpool_t pool, uint32_t tag, size_t* cancelled)
+{
+    if (cancelled != NULL) {
+        *cancelled = 0;
+    }
+
+    if (tag == 0) {
+        return CF_ERROR_INVALID_PARAM;
+    }
+
+    struct cf_threadpool_s* p = resolve_pool(pool);
+
+    if (!p->initialized) {
+        return CF_ERROR_NOT_INITIALIZED;
+    }
+
+    uint32_t total = 0;
+    cf_threadpool_task_t hooked;
+
+    // One pass per task with a discard hook, which runs between passes
+    do {
+        uint32_t shared = 0;
+        uint32_t local = 0;
+
+        hooked.function = NULL;
+
+        cf_critical_section_enter();
+        for (uint32_t prio = 0; prio < CF_THREADPOOL_PRIORITY_COUNT; prio++) {
+            uint32_t removed = deque_remove_tagged(p, &p->queues[prio], tag, &hooked);
+            shared += removed;
+            for (uint32_t i = 0; p->work_stealing && p->worker_ctx != NULL && i < p->thread_count; i++) {
+                uint32_t stolen = deque_remove_tagged(p, &p->worker_ctx[i].local[prio], tag, &hooked);
+                local += stolen;
+                removed += stolen;
+            }
+            p->class_queued[prio] -= removed;
+        }
+        shared += edf_remove_tagged(p, tag, &hooked);
+        p->queued -= shared + local;
+        uint32_t wake = CF_MIN(shared, p->space_waiters);
+        cf_critical_section_exit();
+
+        uint32_t removed = shared + local;
+        cf_atomic_fetch_add(&p->total_cancelled, removed);
+        total += removed;
+
+        // The hooked task is retired last so outstanding cannot reach 0 early
+        if (hooked.function != NULL) {
+            retire_tasks(p, removed - 1);
+            discard_task(p, &hooked);
+        } else {
+            retire_tasks(p, removed);
+        }
+
+        // Shared slots freed up for blocked submitters
+        while (wake-- > 0) {
+            cf_semaphore_give(p->space_sem);
+        }
+    } while (hooked.function != NULL);
 
-        cf_task_delay(check_interval);
-        elapsed += check_interval;
+    if (cancelled != NULL) {
+        *cancelled = total;
     }
 
     return CF_OK;
 }
 
+//==============================================================================
+// PUBLIC API IMPLEMENTATION - WORKER STORAGE
+//==============================================================================
+
+void* cf_threadpool_scratch_alloc(size_t size)
+{
+    cf_threadpool_worker_t* self = current_worker();
+
+    if (self == NULL || size == 0) {
+        return NULL;
+    }
+
+    // Both are multiples of the alignment, so the rounded size fits too
+    if (size > self->pool->scratch_size - self->scratch_used) {
+        cf_atomic_fetch_add(&self->pool->scratch_failures, 1);
+        return NULL;
+    }
+
+    void* block = &self->scratch[self->scratch_used];
+    self->scratch_used += (uint32_t)CF_ALIGN_UP(size, CF_THREADPOOL_SCRATCH_ALIGN);
+
+    return block;
+}
+
+size_t cf_threadpool_scratch_remaining(void)
+{
+    cf_threadpool_worker_t* self = current_worker();
+
+    if (self == NULL) {
+        return 0;
+    }
+
+    return self->pool->scratch_size - self->scratch_used;
+}
+
+void** cf_threadpool_worker_local(uint32_t key)
+{
+#if CF_THREADPOOL_WORKER_LOCAL_SLOTS > 0
+    cf_threadpool_worker_t* self = current_worker();
+
+    if (self == NULL || key >= CF_THREADPOOL_WORKER_LOCAL_SLOTS) {
+        return NULL;
+    }
+
+    return &self->locals[key];
+#else
+    (void)key;
+    return NULL;
+#endif
+}
+
+//==============================================================================
+// PUBLIC API IMPLEMENTATION - DEFAULT INSTANCE
+//==============================================================================
+
+cf_status_t cf_threadpool_init(void)
+{
+    cf_threadpool_config_t config;
+    cf_threadpool_config_default(&config);
+    return cf_threadpool_init_with_config(&config);
+}
+
+cf_status_t cf_threadpool_init_with_config(const cf_threadpool_config_t* config)
+{
+    CF_PTR_CHECK(config);
+
+    if (g_default_pool.initialized) {
+        return CF_ERROR_ALREADY_INITIALIZED;
+    }
+
+    return pool_init(&g_default_pool, config);
+}
+
+void cf_threadpool_deinit(bool wait_for_tasks)
+{
+    if (!g_default_pool.initialized) {
+        return;
+    }
+
+    pool_deinit(&g_default_pool, wait_for_tasks);
+}
+
+cf_status_t cf_threadpool_submit(cf_threadpool_task_func_t function,
+                                  void* arg,
+                                  cf_threadpool_priority_t priority,
+                                  uint32_t timeout_ms)
+{
+    return cf_threadpool_submit_to(NULL, function, arg, priority, timeout_ms);
+}
+
+cf_status_t cf_threadpool_submit_deadline(cf_threadpool_task_func_t function,
+                                           void* arg,
+                                           uint32_t deadline_tick,
+                                           uint32_t timeout_ms)
+{
+    return cf_threadpool_submit_deadline_to(NULL, function, arg, deadline_tick, timeout_ms);
+}
+
+cf_status_t cf_threadpool_submit_unique(cf_threadpool_task_func_t function,
+                                         void* arg,
+                                         uintptr_t key,
+                                         cf_threadpool_priority_t priority,
+                                         uint32_t timeout_ms)
+{
+    return cf_threadpool_submit_unique_to(NULL, function, arg, key, priority, timeout_ms);
+}
+
+cf_status_t cf_threadpool_submit_copy(cf_threadpool_task_func_t function,
+                                       const void* data,
+                                       size_t size,
+                                       cf_threadpool_priority_t priority,
+                                       uint32_t timeout_ms)
+{
+    return cf_threadpool_submit_copy_to(NULL, function, data, size, priority, timeout_ms);
+}
+
+cf_status_t cf_threadpool_submit_from_isr(cf_threadpool_task_func_t function,
+                                           void* arg,
+                                           cf_threadpool_priority_t priority,
+                                           uint32_t timeout_ms,
+                                           BaseType_t* pxHigherPriorityTaskWoken)
+{
+    CF_PTR_CHECK(function);
+
+    // Timeout must be 0 in ISR
+    if (timeout_ms != 0) {
+        return CF_ERROR_INVALID_PARAM;
+    }
+
+    return cf_threadpool_submit_to_from_isr(NULL, function, arg, priority, pxHigherPriorityTaskWoken);
+}
+
+cf_status_t cf_threadpool_submit_batch(const cf_threadpool_job_t* jobs,
+                                        size_t n,
+                                        uint32_t timeout_ms,
+                                        size_t* accepted)
+{
+    return cf_threadpool_submit_batch_to(NULL, jobs, n, timeout_ms, accepted);
+}
+
+cf_status_t cf_threadpool_submit_batch_from_isr(const cf_threadpool_job_t* jobs,
+                                                 size_t n,
+                                                 size_t* accepted,
+                                                 BaseType_t* pxHigherPriorityTaskWoken)
+{
+    return cf_threadpool_submit_batch_to_from_isr(NULL, jobs, n, accepted, pxHigherPriorityTaskWoken);
+}
+
+uint32_t cf_threadpool_get_active_count(void)
+{
+    cf_threadpool_stats_t stats;
+    cf_threadpool_get_stats(NULL, &stats);
+    return stats.active_tasks;
+}
+
+uint32_t cf_threadpool_get_pending_count(void)
+{
+    cf_threadpool_stats_t stats;
+    cf_threadpool_get_stats(NULL, &stats);
+    return stats.pending_tasks;
+}
+
+bool cf_threadpool_is_idle(void)
+{
+    cf_threadpool_stats_t stats;
+    cf_threadpool_get_stats(NULL, &stats);
+    return stats.active_tasks == 0 && stats.pending_tasks == 0;
+}
+
+cf_threadpool_state_t cf_threadpool_get_state(void)
+{
+    return g_default_pool.state;
+}
+
+cf_status_t cf_threadpool_wait_idle(uint32_t timeout_ms)
+{
+    return cf_threadpool_wait_idle_on(NULL, timeout_ms);
+}
+
 void cf_threadpool_config_default(cf_threadpool_config_t* config)
 {
     if (config == NULL) {
@@ -525,6 +3222,28 @@ void cf_threadpool_config_default(cf_threadpool_config_t* config)
     config->queue_size = CF_THREADPOOL_QUEUE_SIZE;
     config->stack_size = CF_THREADPOOL_STACK_SIZE;
     config->thread_priority = CF_TASK_PRIORITY_NORMAL;
+    config->work_stealing = CF_THREADPOOL_WORK_STEALING;
+    config->name = NULL;
+    config->min_threads = 0;
+    config->max_threads = 0;
+    config->scale_up_threshold = CF_THREADPOOL_SCALE_UP_THRESHOLD;
+    config->scale_up_delay_ms = CF_THREADPOOL_SCALE_UP_DELAY_MS;
+    config->idle_timeout_ms = CF_THREADPOOL_IDLE_TIMEOUT_MS;
+    config->sched_policy = CF_THREADPOOL_SCHED_POLICY;
+    memcpy(config->class_weights, g_default_weights, sizeof(config->class_weights));
+    config->aging_step_ms = CF_THREADPOOL_AGING_STEP_MS;
+    config->deadline_queue_size = CF_THREADPOOL_DEADLINE_QUEUE_SIZE;
+    config->drop_late = CF_THREADPOOL_DROP_LATE;
+    for (uint32_t prio = 0; prio < CF_THREADPOOL_PRIORITY_COUNT; prio++) {
+        config->overload_policy[prio] = CF_THREADPOOL_OVERLOAD_POLICY;
+    }
+    config->drop_callback = NULL;
+    config->drop_user_data = NULL;
+    config->scratch_size = CF_THREADPOOL_SCRATCH_SIZE;
+    config->local_free = NULL;
+    config->priority_inherit = CF_THREADPOOL_PRIORITY_INHERIT;
+    config->unique_slots = CF_THREADPOOL_UNIQUE_SLOTS;
+    memcpy(config->job_priority, g_default_job_priority, sizeof(config->job_priority));
 }
 
 #endif /* CF_THREADPOOL_ENABLED && CF_RTOS_ENABLED */
@@ -19,13 +19,43 @@ extern "C" {
 #include "cf_common.h"
 
 #include "os/cf_task.h"
+#include "os/cf_atomic.h"
 
 #if CF_THREADPOOL_ENABLED && CF_RTOS_ENABLED
 
+//==============================================================================
+// CONSTANTS
+//==============================================================================
+
+/**
+ * @brief Number of log2 buckets in latency histograms
+ *
+ * Bucket 0 counts samples below 1 us, bucket b counts [2^(b-1), 2^b) us and
+ * the last bucket is open-ended (>= 2^(BUCKETS-2) us, about 262 ms).
+ */
+#define CF_THREADPOOL_LATENCY_BUCKETS   20
+
+/**
+ * @brief Alignment guaranteed for inline job payloads
+ */
+#define CF_THREADPOOL_INLINE_ARG_ALIGN  8
+
+/**
+ * @brief Alignment of blocks returned by cf_threadpool_scratch_alloc()
+ */
+#define CF_THREADPOOL_SCRATCH_ALIGN     8
+
 //==============================================================================
 // TYPE DEFINITIONS
 //==============================================================================
 
+/**
+ * @brief Opaque ThreadPool handle
+ *
+ * NULL selects the default instance (the one managed by cf_threadpool_init()).
+ */
+typedef struct cf_threadpool_s* cf_threadpool_t;
+
 /**
  * @brief Task function type
  */
@@ -38,17 +68,127 @@ typedef enum {
     CF_THREADPOOL_PRIORITY_LOW,
     CF_THREADPOOL_PRIORITY_NORMAL,
     CF_THREADPOOL_PRIORITY_HIGH,
-    CF_THREADPOOL_PRIORITY_CRITICAL
+    CF_THREADPOOL_PRIORITY_CRITICAL,
+    CF_THREADPOOL_PRIORITY_COUNT
 } cf_threadpool_priority_t;
 
+/**
+ * @brief Order in which workers serve the priority classes
+ */
+typedef enum {
+    CF_THREADPOOL_SCHED_STRICT,     /**< Always the highest non-empty class */
+    CF_THREADPOOL_SCHED_WEIGHTED,   /**< Weighted round-robin over the non-empty classes */
+    CF_THREADPOOL_SCHED_AGING       /**< Waiting raises a task's effective priority */
+} cf_threadpool_sched_policy_t;
+
+/**
+ * @brief What a submission does when the queue for its class is full
+ */
+typedef enum {
+    CF_THREADPOOL_OVERLOAD_BLOCK,       /**< Wait up to timeout_ms for space */
+    CF_THREADPOOL_OVERLOAD_REJECT,      /**< Fail at once with CF_ERROR_QUEUE_FULL */
+    CF_THREADPOOL_OVERLOAD_CALLER_RUNS, /**< Run the job inline on the submitting task */
+    CF_THREADPOOL_OVERLOAD_DROP_OLDEST  /**< Evict the stalest queued job of the class */
+} cf_threadpool_overload_policy_t;
+
+/**
+ * @brief Cooperative cancellation token
+ *
+ * Attached to jobs through cf_threadpool_job_t. Queued jobs whose token is
+ * cancelled are dropped without running; a running job polls
+ * cf_cancel_requested() and returns early. One token may be shared by any
+ * number of jobs and must outlive all of them.
+ */
+typedef struct {
+    cf_atomic_u32_t cancelled;
+} cf_cancel_token_t;
+
+/**
+ * @brief Job descriptor for batch submission
+ *
+ * Zero-initialize descriptors (e.g. with designated initializers) so that
+ * optional fields left unset mean "none".
+ *
+ * discard gets the same argument as function and is called on a task
+ * (never in an ISR) when the job is dropped without running: its token was
+ * cancelled, it was late under drop_late, its tag was cancelled, or the pool
+ * was destroyed without waiting. It lets the owner of the argument release
+ * it or report the failure. Jobs with a discard hook are never evicted by
+ * CF_THREADPOOL_OVERLOAD_DROP_OLDEST, whose callback may run in an ISR.
+ */
+typedef struct {
+    cf_threadpool_task_func_t function; /**< Task function to execute */
+    void* arg;                          /**< Argument to pass to function */
+    cf_threadpool_priority_t priority;  /**< Task priority (for queue ordering) */
+    const void* data;                   /**< Payload copied into the queue slot; replaces arg */
+    size_t data_size;                   /**< Payload size (0 = pass arg, max CF_THREADPOOL_INLINE_ARG_SIZE) */
+    cf_cancel_token_t* token;           /**< Cancellation token (NULL = none) */
+    uint32_t tag;                       /**< Tag for cf_threadpool_cancel_tagged() (0 = none) */
+    bool has_deadline;                  /**< Schedule by deadline instead of priority */
+    uint32_t deadline;                  /**< Absolute deadline (cf_time_get_tick_count() ticks) */
+    bool coalesce;                      /**< Merge into a queued job with the same function and key */
+    uintptr_t key;                      /**< Coalescing key (only with coalesce) */
+    cf_threadpool_task_func_t discard;  /**< Called instead of function if the job is dropped (NULL = none) */
+    bool no_caller_runs;                /**< Fail with CF_ERROR_QUEUE_FULL rather than run on the submitter */
+} cf_threadpool_job_t;
+
+/**
+ * @brief Callback for jobs evicted by CF_THREADPOOL_OVERLOAD_DROP_OLDEST
+ *
+ * Lets the owner release resources referenced by the job. job->data points
+ * at the queued payload copy and is valid only during the call.
+ */
+typedef void (*cf_threadpool_drop_func_t)(const cf_threadpool_job_t* job, void* user_data);
+
+/**
+ * @brief Destructor for worker-local values, called when the pool is destroyed
+ */
+typedef void (*cf_threadpool_local_free_func_t)(uint32_t key, void* value);
+
 /**
  * @brief ThreadPool configuration
  */
 typedef struct {
-    uint32_t thread_count;              /**< Number of worker threads */
+    uint32_t thread_count;              /**< Number of worker threads (fixed mode) */
     uint32_t queue_size;                /**< Task queue size */
     uint32_t stack_size;                /**< Stack size per thread */
     cf_task_priority_t thread_priority; /**< Worker thread priority */
+    bool work_stealing;                 /**< Per-worker deques for tasks submitted from workers */
+    const char* name;                   /**< Worker task name prefix (NULL = "Worker") */
+
+    // Elastic mode (enabled when max_threads > 0; thread_count is then ignored)
+    uint32_t min_threads;               /**< Workers kept alive when idle (>= 1) */
+    uint32_t max_threads;               /**< Upper bound on workers (0 = fixed pool) */
+    uint32_t scale_up_threshold;        /**< Pending depth that adds a worker when none is idle */
+    uint32_t scale_up_delay_ms;         /**< Time that depth must persist before a worker is added */
+    uint32_t idle_timeout_ms;           /**< Idle time before a worker above min_threads retires */
+
+    // Scheduling across priority classes
+    cf_threadpool_sched_policy_t sched_policy;              /**< Class selection policy */
+    uint8_t class_weights[CF_THREADPOOL_PRIORITY_COUNT];    /**< WEIGHTED: dequeues per round (0 = default) */
+    uint32_t aging_step_ms;                                 /**< AGING: wait worth one class (0 = default) */
+
+    // Earliest-deadline-first jobs
+    uint32_t deadline_queue_size;       /**< Deadline heap capacity (0 = deadline jobs not supported) */
+    bool drop_late;                     /**< Drop deadline jobs already late when dequeued */
+
+    // Full queues (indexed by cf_threadpool_priority_t)
+    cf_threadpool_overload_policy_t overload_policy[CF_THREADPOOL_PRIORITY_COUNT];
+    cf_threadpool_drop_func_t drop_callback;    /**< Called for each evicted job (optional) */
+    void* drop_user_data;                       /**< Passed to drop_callback */
+
+    // Per-worker storage
+    uint32_t scratch_size;              /**< Scratch arena bytes per worker (0 = none) */
+    cf_threadpool_local_free_func_t local_free; /**< Releases worker-local values (optional) */
+
+    // Worker priority per job class (indexed by cf_threadpool_priority_t).
+    // Workers park at thread_priority; jobs that block on a mutex still get
+    // FreeRTOS priority inheritance on top of the mapped priority.
+    bool priority_inherit;              /**< Run each job at job_priority[class] instead of thread_priority */
+    cf_task_priority_t job_priority[CF_THREADPOOL_PRIORITY_COUNT]; /**< Default LOW..CRITICAL = BELOW_NORMAL..HIGH */
+
+    // Coalescing
+    uint32_t unique_slots;              /**< Keys of queued coalescing jobs tracked at once (0 = not supported) */
 } cf_threadpool_config_t;
 
 /**
@@ -60,8 +200,614 @@ typedef enum {
     CF_THREADPOOL_SHUTTING_DOWN
 } cf_threadpool_state_t;
 
+/**
+ * @brief ThreadPool statistics snapshot
+ */
+typedef struct {
+    cf_threadpool_state_t state;        /**< Current state */
+    uint32_t thread_count;              /**< Current number of worker threads */
+    uint32_t peak_thread_count;         /**< Highest number of worker threads so far */
+    uint32_t active_tasks;              /**< Tasks currently executing */
+    uint32_t pending_tasks;             /**< Tasks waiting in queues */
+    uint32_t total_submitted;           /**< Tasks accepted since init */
+    uint32_t total_completed;           /**< Tasks finished since init */
+    uint32_t total_cancelled;           /**< Tasks dropped by cancellation since init */
+    uint32_t starved[CF_THREADPOOL_PRIORITY_COUNT];  /**< Dequeues that served another class while this one had tasks waiting */
+    uint32_t promoted[CF_THREADPOOL_PRIORITY_COUNT]; /**< Tasks run ahead of a higher non-empty class by the policy */
+    uint32_t deadline_met;              /**< Deadline tasks finished by their deadline */
+    uint32_t deadline_missed;           /**< Deadline tasks finished late or dropped */
+    uint32_t deadline_dropped;          /**< Deadline tasks dropped because already late */
+    uint32_t deadline_max_lateness_ms;  /**< Worst finish time past a deadline */
+    uint32_t overload_blocked[CF_THREADPOOL_PRIORITY_COUNT];     /**< Submissions that waited for space */
+    uint32_t overload_rejected[CF_THREADPOOL_PRIORITY_COUNT];    /**< Submissions refused for lack of space */
+    uint32_t overload_caller_runs[CF_THREADPOOL_PRIORITY_COUNT]; /**< Jobs run inline by the submitter */
+    uint32_t overload_dropped[CF_THREADPOOL_PRIORITY_COUNT];     /**< Queued jobs evicted for newer ones */
+    uint32_t scratch_peak;              /**< Most scratch bytes used by one job */
+    uint32_t scratch_failures;          /**< Scratch allocations that did not fit */
+    uint32_t coalesced;                 /**< Submissions merged into an already queued job */
+} cf_threadpool_stats_t;
+
+/**
+ * @brief Statistics of one worker slot
+ */
+typedef struct {
+    bool alive;                         /**< Slot holds a running worker */
+    uint32_t stack_size;                /**< Worker stack size in bytes */
+    uint32_t stack_free_min;            /**< Least free stack since the worker started, in bytes (0 if not alive) */
+    uint32_t tasks_completed;           /**< Tasks run by this slot since init */
+} cf_threadpool_worker_stats_t;
+
+/**
+ * @brief Deepest stack use recorded for one job function (calibration mode)
+ */
+typedef struct {
+    cf_threadpool_task_func_t function; /**< Job function */
+    uint32_t stack_used;                /**< Most worker stack in use while it ran, in bytes */
+    uint32_t runs;                      /**< Runs measured */
+} cf_threadpool_stack_profile_t;
+
+/**
+ * @brief Latency histograms for one priority class
+ */
+typedef struct {
+    uint32_t count;                                     /**< Tasks completed */
+    uint32_t wait_max_us;                               /**< Longest submit-to-start time */
+    uint32_t run_max_us;                                /**< Longest execution time */
+    uint32_t wait_hist[CF_THREADPOOL_LATENCY_BUCKETS];  /**< Submit-to-start time histogram */
+    uint32_t run_hist[CF_THREADPOOL_LATENCY_BUCKETS];   /**< Execution time histogram */
+} cf_threadpool_class_latency_t;
+
+/**
+ * @brief Latency statistics snapshot (indexed by cf_threadpool_priority_t)
+ */
+typedef struct {
+    cf_threadpool_class_latency_t classes[CF_THREADPOOL_PRIORITY_COUNT];
+} cf_threadpool_latency_stats_t;
+
+//==============================================================================
+// PUBLIC API - INSTANCES
+//==============================================================================
+
+/**
+ * @brief Create an independent ThreadPool instance
+ *
+ * Each instance has its own workers, queues, stack size and FreeRTOS
+ * priority, so latency-sensitive work can be isolated from bulk work.
+ *
+ * With config->max_threads set, the pool is elastic: it starts with
+ * min_threads workers and adds one once more than scale_up_threshold tasks
+ * have stayed pending, with no worker idle, for scale_up_delay_ms (checked
+ * whenever a task is submitted or dequeued). Workers are created by a
+ * software timer, never on the submitting task, and at most one per
+ * scale_up_delay_ms. Workers above min_threads retire once they have been
+ * idle for idle_timeout_ms. Only running workers hold a stack. With
+ * CF_STATIC_ALLOCATION idle workers are kept instead of retired.
+ *
+ * config->sched_policy selects how workers pick the next priority class,
+ * in O(1) per dequeue:
+ * - STRICT: highest non-empty class; lower classes can starve under load.
+ * - WEIGHTED: each round serves up to class_weights[c] tasks of every
+ *   non-empty class c, highest first (defaults LOW 1, NORMAL 2, HIGH 4,
+ *   CRITICAL 8), so every class gets a guaranteed share.
+ * - AGING: the oldest task of each shared ring gains one class per
+ *   aging_step_ms waited; the class whose oldest task ranks highest is
+ *   served, ties going to the higher class.
+ *
+ * With config->deadline_queue_size set, jobs may carry an absolute
+ * deadline. They are kept in a fixed-capacity binary heap, are served
+ * before all priority classes, earliest deadline first (submission order
+ * breaks ties), and are never placed in work-stealing deques. A deadline
+ * job that finishes after its deadline counts as missed; with
+ * config->drop_late one that is already late when dequeued is dropped
+ * instead of run.
+ *
+ * config->overload_policy[c] decides what a submission of class c does
+ * when its queue (the deadline heap, for deadline jobs) is full:
+ * - BLOCK: wait up to timeout_ms for space (the default).
+ * - REJECT: return CF_ERROR_QUEUE_FULL at once, whatever timeout_ms.
+ * - CALLER_RUNS: run the job on the submitting task before returning
+ *   CF_OK, which throttles the producer to the pool's pace. From ISR
+ *   context, and for jobs with no_caller_runs set, the job is rejected
+ *   instead.
+ * - DROP_OLDEST: evict the oldest job of the class from the shared queue
+ *   (the earliest deadline from the deadline heap), skipping jobs with a
+ *   discard hook, pass it to
+ *   config->drop_callback and queue the new job. The callback runs on the
+ *   submitting task, or in the ISR for ISR submissions.
+ * Each outcome is counted per class in cf_threadpool_stats_t.
+ *
+ * @param[out] pool Pointer to receive pool handle
+ * @param[in] config Pool configuration
+ *
+ * @return CF_OK on success
+ * @return CF_ERROR_NULL_POINTER if pool or config is NULL
+ * @return CF_ERROR_INVALID_PARAM if config parameters are invalid
+ * @return CF_ERROR_NO_MEMORY if creation failed
+ *
+ * @note This function is thread-safe
+ * @note Created pool must be destroyed with cf_threadpool_destroy()
+ */
+cf_status_t cf_threadpool_create(cf_threadpool_t* pool, const cf_threadpool_config_t* config);
+
+/**
+ * @brief Destroy a ThreadPool instance
+ *
+ * New submissions are refused immediately. Each worker is then sent a
+ * poison pill and joined, so the call returns as soon as the last running
+ * task has finished; a running task is never interrupted.
+ *
+ * @param[in] pool Pool handle (NULL and the default instance are ignored)
+ * @param[in] wait_for_tasks true to run all queued tasks first (tasks
+ *                           running on the pool may still submit follow-up
+ *                           tasks meanwhile), false to discard them (their
+ *                           discard hooks are called on the calling task)
+ *
+ * @note Must not be called from one of the pool's own workers
+ */
+void cf_threadpool_destroy(cf_threadpool_t pool, bool wait_for_tasks);
+
+/**
+ * @brief Get handle of the default instance
+ *
+ * @return Default pool handle, or NULL if cf_threadpool_init() was not called
+ */
+cf_threadpool_t cf_threadpool_get_default(void);
+
+/**
+ * @brief Submit task to a specific ThreadPool
+ *
+ * Same semantics as cf_threadpool_submit().
+ *
+ * @param[in] pool Pool handle (NULL = default instance)
+ * @param[in] function Task function to execute
+ * @param[in] arg Argument to pass to function
+ * @param[in] priority Task priority (for queue ordering)
+ * @param[in] timeout_ms Timeout in milliseconds (0 = no wait)
+ *
+ * @return See cf_threadpool_submit()
+ */
+cf_status_t cf_threadpool_submit_to(cf_threadpool_t pool,
+                                     cf_threadpool_task_func_t function,
+                                     void* arg,
+                                     cf_threadpool_priority_t priority,
+                                     uint32_t timeout_ms);
+
+/**
+ * @brief Submit a job descriptor to a specific ThreadPool
+ *
+ * Like cf_threadpool_submit_to(), but also attaches the job's cancellation
+ * token and tag.
+ *
+ * @param[in] pool Pool handle (NULL = default instance)
+ * @param[in] job Job descriptor
+ * @param[in] timeout_ms Timeout in milliseconds (0 = no wait)
+ *
+ * @return CF_ERROR_NULL_POINTER if job or job->function is NULL
+ * @return CF_ERROR_INVALID_PARAM if the job payload is too large
+ * @return CF_ERROR_NOT_SUPPORTED if the job has a deadline and the pool no
+ *         deadline queue, or coalesces and the pool has no unique_slots
+ * @return Otherwise see cf_threadpool_submit()
+ */
+cf_status_t cf_threadpool_submit_job(cf_threadpool_t pool,
+                                      const cf_threadpool_job_t* job,
+                                      uint32_t timeout_ms);
+
+/**
+ * @brief Submit task with an absolute deadline to a specific ThreadPool
+ *
+ * @param[in] pool Pool handle (NULL = default instance)
+ * @param[in] function Task function to execute
+ * @param[in] arg Argument to pass to function
+ * @param[in] deadline_tick Absolute deadline in RTOS ticks (see
+ *                          cf_time_get_tick_count()); must lie within
+ *                          2^31 ticks of the other pending deadlines
+ * @param[in] timeout_ms Timeout in milliseconds (0 = no wait)
+ *
+ * @return CF_ERROR_NOT_SUPPORTED if the pool has no deadline queue
+ * @return CF_ERROR_TIMEOUT or CF_ERROR_QUEUE_FULL if the deadline heap is full
+ * @return Otherwise see cf_threadpool_submit()
+ *
+ * @note This function is thread-safe
+ * @note Latency statistics record deadline tasks under NORMAL priority
+ */
+cf_status_t cf_threadpool_submit_deadline_to(cf_threadpool_t pool,
+                                              cf_threadpool_task_func_t function,
+                                              void* arg,
+                                              uint32_t deadline_tick,
+                                              uint32_t timeout_ms);
+
+/**
+ * @brief Submit task unless the same work is already queued
+ *
+ * If a job with the same function and key is still waiting in the queue,
+ * the submission is merged into it and nothing new is queued; the waiting
+ * job runs once, with its own argument. Once a job has been dequeued, the
+ * next submission queues it again, so work requested while it runs is not
+ * lost. Meant for idempotent jobs such as "refresh display" or "flush
+ * buffer". Pass (uintptr_t)arg as key to merge on (function, arg).
+ *
+ * When the pool's key table is three quarters full the job is queued
+ * without coalescing.
+ *
+ * @param[in] pool Pool handle (NULL = default instance)
+ * @param[in] function Task function to execute
+ * @param[in] arg Argument to pass to function
+ * @param[in] key Identifies the work together with function
+ * @param[in] priority Task priority (for queue ordering)
+ * @param[in] timeout_ms Timeout in milliseconds (0 = no wait)
+ *
+ * @return CF_OK if queued or merged (merges are counted in the coalesced
+ *         statistic)
+ * @return CF_ERROR_NOT_SUPPORTED if the pool has no unique_slots
+ * @return Otherwise see cf_threadpool_submit()
+ *
+ * @note This function is thread-safe
+ */
+cf_status_t cf_threadpool_submit_unique_to(cf_threadpool_t pool,
+                                            cf_threadpool_task_func_t function,
+                                            void* arg,
+                                            uintptr_t key,
+                                            cf_threadpool_priority_t priority,
+                                            uint32_t timeout_ms);
+
+/**
+ * @brief Submit task with an inline payload to a specific ThreadPool
+ *
+ * Copies size bytes into the queue slot; function then receives a pointer
+ * to that copy (aligned to CF_THREADPOOL_INLINE_ARG_ALIGN), valid until it
+ * returns. Small argument structs thus need neither allocation nor free.
+ *
+ * Inline payloads are off by default: every queue slot reserves
+ * CF_THREADPOOL_INLINE_ARG_SIZE bytes for them whether used or not.
+ *
+ * @param[in] pool Pool handle (NULL = default instance)
+ * @param[in] function Task function to execute
+ * @param[in] data Payload to copy
+ * @param[in] size Payload size in bytes (1 to CF_THREADPOOL_INLINE_ARG_SIZE)
+ * @param[in] priority Task priority (for queue ordering)
+ * @param[in] timeout_ms Timeout in milliseconds (0 = no wait)
+ *
+ * @return CF_ERROR_NULL_POINTER if function or data is NULL
+ * @return CF_ERROR_INVALID_PARAM if size is 0 or too large
+ * @return Otherwise see cf_threadpool_submit()
+ *
+ * @note This function is thread-safe
+ */
+cf_status_t cf_threadpool_submit_copy_to(cf_threadpool_t pool,
+                                          cf_threadpool_task_func_t function,
+                                          const void* data,
+                                          size_t size,
+                                          cf_threadpool_priority_t priority,
+                                          uint32_t timeout_ms);
+
+/**
+ * @brief Submit task with an inline payload to a specific ThreadPool from ISR context
+ *
+ * @param[in] pool Pool handle (NULL = default instance)
+ * @param[in] function Task function to execute
+ * @param[in] data Payload to copy
+ * @param[in] size Payload size in bytes (1 to CF_THREADPOOL_INLINE_ARG_SIZE)
+ * @param[in] priority Task priority (for queue ordering)
+ * @param[out] pxHigherPriorityTaskWoken Set to pdTRUE if context switch needed
+ *
+ * @return See cf_threadpool_submit_copy_to() and cf_threadpool_submit_from_isr()
+ *
+ * @note This function is ISR-safe
+ */
+cf_status_t cf_threadpool_submit_copy_to_from_isr(cf_threadpool_t pool,
+                                                   cf_threadpool_task_func_t function,
+                                                   const void* data,
+                                                   size_t size,
+                                                   cf_threadpool_priority_t priority,
+                                                   BaseType_t* pxHigherPriorityTaskWoken);
+
+/**
+ * @brief Submit task to a specific ThreadPool from ISR context
+ *
+ * @param[in] pool Pool handle (NULL = default instance)
+ * @param[in] function Task function to execute
+ * @param[in] arg Argument to pass to function
+ * @param[in] priority Task priority (for queue ordering)
+ * @param[out] pxHigherPriorityTaskWoken Set to pdTRUE if context switch needed
+ *
+ * @return See cf_threadpool_submit_from_isr()
+ */
+cf_status_t cf_threadpool_submit_to_from_isr(cf_threadpool_t pool,
+                                              cf_threadpool_task_func_t function,
+                                              void* arg,
+                                              cf_threadpool_priority_t priority,
+                                              BaseType_t* pxHigherPriorityTaskWoken);
+
+/**
+ * @brief Submit an array of tasks to a specific ThreadPool
+ *
+ * @param[in] pool Pool handle (NULL = default instance)
+ *
+ * @return See cf_threadpool_submit_batch()
+ */
+cf_status_t cf_threadpool_submit_batch_to(cf_threadpool_t pool,
+                                           const cf_threadpool_job_t* jobs,
+                                           size_t n,
+                                           uint32_t timeout_ms,
+                                           size_t* accepted);
+
+/**
+ * @brief Submit an array of tasks to a specific ThreadPool from ISR context
+ *
+ * @param[in] pool Pool handle (NULL = default instance)
+ *
+ * @return See cf_threadpool_submit_batch_from_isr()
+ */
+cf_status_t cf_threadpool_submit_batch_to_from_isr(cf_threadpool_t pool,
+                                                    const cf_threadpool_job_t* jobs,
+                                                    size_t n,
+                                                    size_t* accepted,
+                                                    BaseType_t* pxHigherPriorityTaskWoken);
+
+/**
+ * @brief Get statistics of a ThreadPool
+ *
+ * @param[in] pool Pool handle (NULL = default instance)
+ * @param[out] stats Statistics snapshot (zeroed if not initialized)
+ *
+ * @return CF_OK on success
+ * @return CF_ERROR_NULL_POINTER if stats is NULL
+ * @return CF_ERROR_NOT_INITIALIZED if the pool is not initialized
+ *
+ * @note This function is thread-safe and ISR-safe (lock-free)
+ * @note Counters are read individually, so a snapshot taken while tasks
+ *       are running may be off by one between related fields
+ */
+cf_status_t cf_threadpool_get_stats(cf_threadpool_t pool, cf_threadpool_stats_t* stats);
+
+/**
+ * @brief Get queue-wait and execution-time histograms of a ThreadPool
+ *
+ * Every task is stamped when it is submitted (task or ISR context) and
+ * again when a worker starts and finishes it, using the CPU cycle counter
+ * where the port has one (DWT on Cortex-M, CCOUNT on ESP32) and the RTOS
+ * tick otherwise. Off by default; set CF_THREADPOOL_LATENCY_STATS to 1.
+ *
+ * @param[in] pool Pool handle (NULL = default instance)
+ * @param[out] stats Latency snapshot
+ *
+ * @return CF_OK on success
+ * @return CF_ERROR_NULL_POINTER if stats is NULL
+ * @return CF_ERROR_NOT_INITIALIZED if the pool is not initialized
+ * @return CF_ERROR_NOT_SUPPORTED if CF_THREADPOOL_LATENCY_STATS is 0
+ *
+ * @note This function is thread-safe and ISR-safe
+ */
+cf_status_t cf_threadpool_get_latency_stats(cf_threadpool_t pool, cf_threadpool_latency_stats_t* stats);
+
+/**
+ * @brief Clear the latency histograms of a ThreadPool
+ *
+ * @param[in] pool Pool handle (NULL = default instance)
+ *
+ * @return CF_OK on success
+ * @return CF_ERROR_NOT_INITIALIZED if the pool is not initialized
+ * @return CF_ERROR_NOT_SUPPORTED if CF_THREADPOOL_LATENCY_STATS is 0
+ *
+ * @note This function is thread-safe and ISR-safe
+ */
+cf_status_t cf_threadpool_reset_latency_stats(cf_threadpool_t pool);
+
+/**
+ * @brief Get per-worker statistics of a ThreadPool
+ *
+ * stack_free_min is the FreeRTOS stack high-water mark of the worker, as
+ * the worker itself last sampled it after finishing a task. A worker that
+ * has run a representative load with plenty of free stack left shows how
+ * far config->stack_size can be reduced.
+ *
+ * @param[in] pool Pool handle (NULL = default instance)
+ * @param[out] stats Array receiving one entry per worker slot, indexed by
+ *                   worker id
+ * @param[in] max Number of entries in stats
+ * @param[out] count Number of entries written (optional)
+ *
+ * @return CF_OK on success
+ * @return CF_ERROR_NULL_POINTER if stats is NULL
+ * @return CF_ERROR_NOT_INITIALIZED if the pool is not initialized
+ *
+ * @note Requires INCLUDE_uxTaskGetStackHighWaterMark in FreeRTOSConfig.h
+ * @note This function is thread-safe
+ */
+cf_status_t cf_threadpool_get_worker_stats(cf_threadpool_t pool,
+                                           cf_threadpool_worker_stats_t* stats,
+                                           size_t max,
+                                           size_t* count);
+
+/**
+ * @brief Get the deepest stack use recorded per job function
+ *
+ * With CF_THREADPOOL_STACK_CALIBRATION the worker paints its free stack
+ * before each job and scans it afterwards. The figure includes the
+ * worker's own frames and any interrupt frames taken during the job, so it
+ * is the stack a worker needs to run that function. The first
+ * CF_THREADPOOL_STACK_PROFILE_SLOTS distinct functions are tracked.
+ *
+ * Calibration costs a pass over the free stack per job and is meant for
+ * development builds only.
+ *
+ * @param[in] pool Pool handle (NULL = default instance)
+ * @param[out] profile Array receiving one entry per function seen
+ * @param[in] max Number of entries in profile
+ * @param[out] count Number of entries written (optional)
+ *
+ * @return CF_OK on success
+ * @return CF_ERROR_NULL_POINTER if profile is NULL
+ * @return CF_ERROR_NOT_INITIALIZED if the pool is not initialized
+ * @return CF_ERROR_NOT_SUPPORTED if CF_THREADPOOL_STACK_CALIBRATION is 0
+ *
+ * @note This function is thread-safe
+ */
+cf_status_t cf_threadpool_get_stack_profile(cf_threadpool_t pool,
+                                            cf_threadpool_stack_profile_t* profile,
+                                            size_t max,
+                                            size_t* count);
+
+/**
+ * @brief Estimate a percentile from a latency histogram
+ *
+ * @param[in] hist Histogram (wait_hist or run_hist)
+ * @param[in] percent Percentile to compute (1-100, e.g. 50 or 99)
+ *
+ * @return Upper bound of the bucket holding the percentile, in microseconds
+ * @return 0 if the histogram is empty
+ * @return UINT32_MAX if the percentile lies in the open-ended last bucket
+ */
+uint32_t cf_threadpool_latency_percentile(const uint32_t hist[CF_THREADPOOL_LATENCY_BUCKETS],
+                                          uint32_t percent);
+
+/**
+ * @brief Wait for all tasks of a ThreadPool to complete
+ *
+ * Blocks on a semaphore that the worker finishing the last outstanding
+ * task signals; there is no polling. Any number of tasks may wait at once.
+ *
+ * @param[in] pool Pool handle (NULL = default instance)
+ * @param[in] timeout_ms Timeout in milliseconds (CF_WAIT_FOREVER for infinite)
+ *
+ * @return CF_OK if all tasks completed
+ * @return CF_ERROR_TIMEOUT if timeout occurred
+ * @return CF_ERROR_NOT_INITIALIZED if not initialized
+ *
+ * @note This function is thread-safe
+ * @note Must not be called from one of the pool's own workers
+ */
+cf_status_t cf_threadpool_wait_idle_on(cf_threadpool_t pool, uint32_t timeout_ms);
+
+//==============================================================================
+// PUBLIC API - CANCELLATION
+//==============================================================================
+
+/**
+ * @brief Initialize a cancellation token (not cancelled)
+ *
+ * @param[out] token Token to initialize
+ *
+ * @note A zero-initialized token is also valid
+ */
+void cf_cancel_token_init(cf_cancel_token_t* token);
+
+/**
+ * @brief Request cancellation of every job carrying a token
+ *
+ * Jobs still queued are dropped when a worker dequeues them; jobs already
+ * running see cf_cancel_requested() return true.
+ *
+ * @param[in] token Token to cancel (NULL is ignored)
+ *
+ * @note This function is thread-safe and ISR-safe
+ */
+void cf_cancel_token_cancel(cf_cancel_token_t* token);
+
+/**
+ * @brief Re-arm a token for new jobs
+ *
+ * @param[in] token Token to reset (NULL is ignored)
+ *
+ * @note Jobs still queued with this token will run again
+ */
+void cf_cancel_token_reset(cf_cancel_token_t* token);
+
+/**
+ * @brief Check whether a token has been cancelled
+ *
+ * @param[in] token Token to check
+ *
+ * @return true if cancelled, false otherwise (or if token is NULL)
+ *
+ * @note This function is thread-safe and ISR-safe
+ */
+bool cf_cancel_token_is_cancelled(const cf_cancel_token_t* token);
+
+/**
+ * @brief Check whether the job running on the calling worker was cancelled
+ *
+ * Intended to be polled by long-running jobs at convenient points.
+ *
+ * @return true if the current job's token has been cancelled
+ * @return false if it has not, if the job has no token, or if the caller is
+ *         not a ThreadPool worker
+ *
+ * @note This function is thread-safe
+ */
+bool cf_cancel_requested(void);
+
+/**
+ * @brief Drop every queued job with a given tag
+ *
+ * Jobs already running are not affected; give them a token as well if they
+ * should stop early. Discard hooks of the dropped jobs are called on the
+ * calling task, each outside the critical section.
+ *
+ * @param[in] pool Pool handle (NULL = default instance)
+ * @param[in] tag Tag passed in cf_threadpool_job_t (must not be 0)
+ * @param[out] cancelled Number of jobs dropped (may be NULL)
+ *
+ * @return CF_OK on success
+ * @return CF_ERROR_INVALID_PARAM if tag is 0
+ * @return CF_ERROR_NOT_INITIALIZED if the pool is not initialized
+ *
+ * @note This function is thread-safe
+ * @note Scans every queue inside one critical section (one more per job
+ *       with a discard hook), so the time with interrupts masked grows
+ *       with the queue size
+ */
+cf_status_t cf_threadpool_cancel_tagged(cf_threadpool_t pool, uint32_t tag, size_t* cancelled);
+
+//==============================================================================
+// PUBLIC API - WORKER STORAGE
+//==============================================================================
+
+/**
+ * @brief Allocate temporary memory for the running job
+ *
+ * Bumps a pointer in the calling worker's scratch arena of config->scratch_size
+ * bytes, so it is O(1) and takes no lock. There is no free: the arena is
+ * reset when the job returns, and the memory must not be used afterwards.
+ *
+ * @param[in] size Number of bytes (rounded up to CF_THREADPOOL_SCRATCH_ALIGN)
+ *
+ * @return Block aligned to CF_THREADPOOL_SCRATCH_ALIGN
+ * @return NULL if size is 0, the arena is exhausted or disabled, or the
+ *         caller is not a ThreadPool worker
+ *
+ * @note Only the job running on the worker may call this
+ * @note The worker is found through FreeRTOS thread-local storage when
+ *       CF_THREADPOOL_TLS_INDEX is set, otherwise by scanning the workers
+ *       of every pool
+ */
+void* cf_threadpool_scratch_alloc(size_t size);
+
+/**
+ * @brief Get the scratch bytes left for the running job
+ *
+ * @return Bytes available (0 if the caller is not a ThreadPool worker)
+ */
+size_t cf_threadpool_scratch_remaining(void);
+
+/**
+ * @brief Get a worker-local storage slot
+ *
+ * Each worker slot of a pool has CF_THREADPOOL_WORKER_LOCAL_SLOTS pointers
+ * that start out NULL and keep their value across jobs, e.g. to build a
+ * per-worker cache lazily on first use without locking. In elastic mode a
+ * worker started later in the same slot inherits the values. When the pool
+ * is destroyed, config->local_free is called for every non-NULL value.
+ *
+ * @param[in] key Slot index (< CF_THREADPOOL_WORKER_LOCAL_SLOTS)
+ *
+ * @return Pointer to the slot of the calling worker
+ * @return NULL if key is out of range or the caller is not a ThreadPool worker
+ */
+void** cf_threadpool_worker_local(uint32_t key);
+
 //==============================================================================
-// PUBLIC API
+// PUBLIC API - DEFAULT INSTANCE
 //==============================================================================
 
 /**
@@ -93,7 +839,11 @@ cf_status_t cf_threadpool_init_with_config(const cf_threadpool_config_t* config)
 /**
  * @brief Deinitialize ThreadPool
  *
- * @param[in] wait_for_tasks true to wait for running tasks to complete
+ * Workers are stopped with poison pills and joined; see
+ * cf_threadpool_destroy().
+ *
+ * @param[in] wait_for_tasks true to run all queued tasks first, false to
+ *                           discard them (running tasks always complete)
  *
  * @note This function is thread-safe
  */
@@ -115,12 +865,50 @@ void cf_threadpool_deinit(bool wait_for_tasks);
  * @return CF_ERROR_QUEUE_FULL if queue is full
  *
  * @note This function is thread-safe
+ * @note The overload policy of the class applies when the queue is full;
+ *       timeout_ms is used only by CF_THREADPOOL_OVERLOAD_BLOCK
+ * @note An idle worker is woken immediately, whatever the priority
+ * @note With work_stealing enabled, tasks submitted from a worker go to that
+ *       worker's own deque (falling back to the shared queue when full);
+ *       idle workers steal them, oldest first, within the same priority
  */
 cf_status_t cf_threadpool_submit(cf_threadpool_task_func_t function,
                                   void* arg,
                                   cf_threadpool_priority_t priority,
                                   uint32_t timeout_ms);
 
+/**
+ * @brief Submit task with an absolute deadline to the default ThreadPool
+ *
+ * @return See cf_threadpool_submit_deadline_to()
+ */
+cf_status_t cf_threadpool_submit_deadline(cf_threadpool_task_func_t function,
+                                           void* arg,
+                                           uint32_t deadline_tick,
+                                           uint32_t timeout_ms);
+
+/**
+ * @brief Submit task to the default ThreadPool unless already queued
+ *
+ * @return See cf_threadpool_submit_unique_to()
+ */
+cf_status_t cf_threadpool_submit_unique(cf_threadpool_task_func_t function,
+                                         void* arg,
+                                         uintptr_t key,
+                                         cf_threadpool_priority_t priority,
+                                         uint32_t timeout_ms);
+
+/**
+ * @brief Submit task with an inline payload to the default ThreadPool
+ *
+ * @return See cf_threadpool_submit_copy_to()
+ */
+cf_status_t cf_threadpool_submit_copy(cf_threadpool_task_func_t function,
+                                       const void* data,
+                                       size_t size,
+                                       cf_threadpool_priority_t priority,
+                                       uint32_t timeout_ms);
+
 /**
  * @brief Submit task to ThreadPool from ISR context
  *
@@ -136,7 +924,7 @@ cf_status_t cf_threadpool_submit(cf_threadpool_task_func_t function,
  * @return CF_ERROR_INVALID_STATE if ThreadPool is shutting down
  * @return CF_ERROR_QUEUE_FULL if queue is full
  *
- * @note This function is ISR-safe (FreeRTOS FromISR variant)
+ * @note This function is ISR-safe
  * @note Caller must call portYIELD_FROM_ISR() if pxHigherPriorityTaskWoken is set
  */
 cf_status_t cf_threadpool_submit_from_isr(cf_threadpool_task_func_t function,
@@ -145,12 +933,70 @@ cf_status_t cf_threadpool_submit_from_isr(cf_threadpool_task_func_t function,
                                            uint32_t timeout_ms,
                                            BaseType_t* pxHigherPriorityTaskWoken);
 
+/**
+ * @brief Submit an array of tasks to ThreadPool
+ *
+ * Jobs are enqueued in array order under a single critical section and
+ * exactly as many idle workers are woken as there are jobs accepted. If a
+ * queue fills up and its overload policy gives up, submission stops there:
+ * accepted jobs (including jobs run inline under CALLER_RUNS) always form a
+ * prefix of the array, so the caller can resubmit from jobs[*accepted].
+ *
+ * @param[in] jobs Array of jobs
+ * @param[in] n Number of jobs in the array
+ * @param[in] timeout_ms Time to wait for queue space (0 = no wait)
+ * @param[out] accepted Number of jobs enqueued (optional)
+ *
+ * @return CF_OK if all jobs were enqueued
+ * @return CF_ERROR_NULL_POINTER if jobs or any job function is NULL
+ * @return CF_ERROR_INVALID_PARAM if a job payload is too large
+ * @return CF_ERROR_NOT_SUPPORTED if a job has a deadline and the pool no
+ *         deadline queue
+ * @return CF_ERROR_NOT_INITIALIZED if ThreadPool not initialized
+ * @return CF_ERROR_INVALID_STATE if ThreadPool is shutting down
+ * @return CF_ERROR_TIMEOUT if timeout occurred before all jobs fit
+ * @return CF_ERROR_QUEUE_FULL if a queue is full and timeout_ms is 0
+ *
+ * @note This function is thread-safe
+ */
+cf_status_t cf_threadpool_submit_batch(const cf_threadpool_job_t* jobs,
+                                        size_t n,
+                                        uint32_t timeout_ms,
+                                        size_t* accepted);
+
+/**
+ * @brief Submit an array of tasks to ThreadPool from ISR context
+ *
+ * Same semantics as cf_threadpool_submit_batch() with no waiting.
+ *
+ * @param[in] jobs Array of jobs
+ * @param[in] n Number of jobs in the array
+ * @param[out] accepted Number of jobs enqueued (optional)
+ * @param[out] pxHigherPriorityTaskWoken Set to pdTRUE if context switch needed
+ *
+ * @return CF_OK if all jobs were enqueued
+ * @return CF_ERROR_NULL_POINTER if jobs or any job function is NULL
+ * @return CF_ERROR_INVALID_PARAM if a job payload is too large
+ * @return CF_ERROR_NOT_SUPPORTED if a job has a deadline and the pool no
+ *         deadline queue
+ * @return CF_ERROR_NOT_INITIALIZED if ThreadPool not initialized
+ * @return CF_ERROR_INVALID_STATE if ThreadPool is shutting down
+ * @return CF_ERROR_QUEUE_FULL if a queue filled up
+ *
+ * @note This function is ISR-safe
+ * @note Caller must call portYIELD_FROM_ISR() if pxHigherPriorityTaskWoken is set
+ */
+cf_status_t cf_threadpool_submit_batch_from_isr(const cf_threadpool_job_t* jobs,
+                                                 size_t n,
+                                                 size_t* accepted,
+                                                 BaseType_t* pxHigherPriorityTaskWoken);
+
 /**
  * @brief Get number of active tasks
  *
  * @return Number of active tasks (0 if not initialized)
  *
- * @note This function is thread-safe
+ * @note This function is thread-safe and ISR-safe
  */
 uint32_t cf_threadpool_get_active_count(void);
 
@@ -159,7 +1005,7 @@ uint32_t cf_threadpool_get_active_count(void);
  *
  * @return Number of pending tasks (0 if not initialized)
  *
- * @note This function is thread-safe
+ * @note This function is thread-safe and ISR-safe
  */
 uint32_t cf_threadpool_get_pending_count(void);
 
@@ -168,7 +1014,7 @@ uint32_t cf_threadpool_get_pending_count(void);
  *
  * @return true if idle, false otherwise
  *
- * @note This function is thread-safe
+ * @note This function is thread-safe and ISR-safe
  */
 bool cf_threadpool_is_idle(void);
 
@@ -191,6 +1037,7 @@ cf_threadpool_state_t cf_threadpool_get_state(void);
  * @return CF_ERROR_NOT_INITIALIZED if not initialized
  *
  * @note This function is thread-safe
+ * @note Must not be called from a ThreadPool worker
  */
 cf_status_t cf_threadpool_wait_idle(uint32_t timeout_ms);
 
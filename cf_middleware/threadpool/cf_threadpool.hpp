@@ -0,0 +1,140 @@
+/**
+ * @file cf_threadpool.hpp
+ * @brief ThreadPool C++ wrapper - lambdas with inline captures
+ * @version 1.0.0
+ * @date 2025-11-20
+ * @author CFramework Contributors
+ *
+ * @copyright Copyright (c) 2025 CFramework
+ * Licensed under MIT License
+ *
+ * @description
+ * Submits callables (typically lambdas) by copying them into the job's
+ * inline payload, so a capturing lambda costs no allocation. Captures must
+ * be trivially copyable and fit in CF_THREADPOOL_INLINE_ARG_SIZE bytes;
+ * both are checked at compile time. Capture pointers or references to
+ * larger state instead of copying it. Only available when
+ * CF_THREADPOOL_INLINE_ARG_SIZE is set above 0.
+ *
+ * @code
+ * uint32_t sample = read_adc();
+ * cf::threadpool::submit([sample, &filter]() { filter.push(sample); });
+ * @endcode
+ */
+
+#ifndef CF_THREADPOOL_HPP
+#define CF_THREADPOOL_HPP
+
+#include "threadpool/cf_threadpool.h"
+
+#if CF_THREADPOOL_ENABLED && CF_RTOS_ENABLED && CF_THREADPOOL_INLINE_ARG_SIZE > 0
+
+#include <type_traits>
+
+namespace cf {
+namespace threadpool {
+
+namespace detail {
+
+/**
+ * @brief Task function running the callable copied into the payload
+ */
+template <typename F>
+void invoke(void* payload)
+{
+    (*static_cast<F*>(payload))();
+}
+
+/**
+ * @brief Compile-time checks for callables stored inline
+ */
+template <typename F>
+struct inline_callable {
+    static_assert(std::is_trivially_copyable<F>::value,
+                  "callable is copied bytewise into the queue slot: captures must be trivially copyable");
+    static_assert(sizeof(F) <= CF_THREADPOOL_INLINE_ARG_SIZE,
+                  "callable captures exceed CF_THREADPOOL_INLINE_ARG_SIZE");
+    static_assert(alignof(F) <= CF_THREADPOOL_INLINE_ARG_ALIGN,
+                  "callable alignment exceeds CF_THREADPOOL_INLINE_ARG_ALIGN");
+    static constexpr cf_threadpool_task_func_t function = &invoke<F>;
+};
+
+} // namespace detail
+
+/**
+ * @brief Submit a callable to a specific ThreadPool
+ *
+ * @param[in] pool Pool handle (NULL = default instance)
+ * @param[in] fn Callable taking no arguments (copied)
+ * @param[in] priority Task priority (for queue ordering)
+ * @param[in] timeout_ms Timeout in milliseconds (0 = no wait)
+ *
+ * @return See cf_threadpool_submit_copy_to()
+ *
+ * @note This function is thread-safe
+ */
+template <typename F>
+inline cf_status_t submit_to(cf_threadpool_t pool,
+                             const F& fn,
+                             cf_threadpool_priority_t priority = CF_THREADPOOL_PRIORITY_NORMAL,
+                             uint32_t timeout_ms = 0)
+{
+    return cf_threadpool_submit_copy_to(pool, detail::inline_callable<F>::function,
+                                        &fn, sizeof(F), priority, timeout_ms);
+}
+
+/**
+ * @brief Submit a callable to the default ThreadPool
+ *
+ * @return See submit_to()
+ */
+template <typename F>
+inline cf_status_t submit(const F& fn,
+                          cf_threadpool_priority_t priority = CF_THREADPOOL_PRIORITY_NORMAL,
+                          uint32_t timeout_ms = 0)
+{
+    return submit_to(nullptr, fn, priority, timeout_ms);
+}
+
+/**
+ * @brief Submit a callable to a specific ThreadPool from ISR context
+ *
+ * @param[in] pool Pool handle (NULL = default instance)
+ * @param[in] fn Callable taking no arguments (copied)
+ * @param[in] priority Task priority (for queue ordering)
+ * @param[out] pxHigherPriorityTaskWoken Set to pdTRUE if context switch needed
+ *
+ * @return See cf_threadpool_submit_copy_to_from_isr()
+ *
+ * @note This function is ISR-safe
+ */
+template <typename F>
+inline cf_status_t submit_to_from_isr(cf_threadpool_t pool,
+                                      const F& fn,
+                                      cf_threadpool_priority_t priority,
+                                      BaseType_t* pxHigherPriorityTaskWoken)
+{
+    return cf_threadpool_submit_copy_to_from_isr(pool, detail::inline_callable<F>::function,
+                                                 &fn, sizeof(F), priority,
+                                                 pxHigherPriorityTaskWoken);
+}
+
+/**
+ * @brief Submit a callable to the default ThreadPool from ISR context
+ *
+ * @return See submit_to_from_isr()
+ */
+template <typename F>
+inline cf_status_t submit_from_isr(const F& fn,
+                                   cf_threadpool_priority_t priority,
+                                   BaseType_t* pxHigherPriorityTaskWoken)
+{
+    return submit_to_from_isr(nullptr, fn, priority, pxHigherPriorityTaskWoken);
+}
+
+} // namespace threadpool
+} // namespace cf
+
+#endif /* CF_THREADPOOL_ENABLED && CF_RTOS_ENABLED && CF_THREADPOOL_INLINE_ARG_SIZE > 0 */
+
+#endif /* CF_THREADPOOL_HPP */
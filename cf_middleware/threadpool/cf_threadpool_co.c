@@ -0,0 +1,879 @@
+/**
+ * @file cf_threadpool_co.c
+ * @brief Stackless coroutine scheduler implementation
+ */
+
+#include "threadpool/cf_threadpool_co.h"
+
+#if CF_THREADPOOL_ENABLED && CF_RTOS_ENABLED
+
+#include "cf_assert.h"
+#include "os/cf_critical.h"
+#include "os/cf_task.h"
+#include "os/cf_time.h"
+#include "os/cf_timer.h"
+
+#include <string.h>
+
+//==============================================================================
+// PRIVATE DEFINITIONS
+//==============================================================================
+
+#define CO_WHEEL_SIZE       64      /**< Timeout wheel slots (power of two) */
+#define CO_QUEUE_BUCKETS    16      /**< Queue waiter lists (power of two) */
+#define CO_EVENT_BUCKETS    16      /**< Event waiter lists (power of two) */
+#define CO_MAX_TICKS        0x7FFFFFFFUL
+
+//==============================================================================
+// PRIVATE TYPES
+//==============================================================================
+
+/**
+ * @brief Coroutine state
+ */
+typedef enum {
+    CO_IDLE = 0,                /**< Never started or finished */
+    CO_READY,                   /**< Step submitted to the pool */
+    CO_RUNNING,
+    CO_WAITING                  /**< Linked into the scheduler */
+} co_state_t;
+
+/**
+ * @brief What a suspended coroutine waits for
+ */
+typedef enum {
+    CO_WAIT_NONE = 0,           /**< Yield: resubmit immediately */
+    CO_WAIT_SLEEP,
+    CO_WAIT_QUEUE,
+    CO_WAIT_EVENT,
+    CO_WAIT_DELIVER             /**< Event taken by a publisher, wake in progress */
+} co_wait_t;
+
+/**
+ * @brief Scheduler
+ *
+ * Waiting coroutines are linked into exactly one wait list (a queue or an
+ * event bucket; none for sleeps) and, if their wait can time out, into the
+ * wheel slot of their deadline. A slot is swept every tick and holds
+ * deadlines that are a multiple of CO_WHEEL_SIZE apart, so long waits cost
+ * one comparison per wheel turn. The driver only runs while something is
+ * linked into the wheel or the retry list. All fields are guarded by the
+ * critical section.
+ */
+typedef struct {
+    bool initialized;
+    bool initializing;
+
+    cf_timer_t driver;
+    bool driving;               /**< Driver started (or a start is on its way) */
+    TickType_t tick_period;     /**< OS ticks per scheduler tick */
+    TickType_t last_os_tick;
+    uint32_t now;               /**< Current scheduler tick */
+
+    cf_co_t* wheel[CO_WHEEL_SIZE];
+    cf_co_t* queues[CO_QUEUE_BUCKETS]; /**< Waiting on a queue, hashed by queue */
+    cf_co_t* retry;             /**< Ready, but the pool queue was full */
+
+#if CF_EVENT_ENABLED
+    bool subscribed;
+    bool subscribing;           /**< Subscribing or unsubscribing */
+    cf_event_subscriber_t subscription;
+    uint32_t event_waiters;     /**< Linked into events */
+    cf_co_t* events[CO_EVENT_BUCKETS];
+#endif
+} cf_co_sched_t;
+
+//==============================================================================
+// PRIVATE VARIABLES
+//==============================================================================
+
+static cf_co_sched_t g_sched;
+
+//==============================================================================
+// PRIVATE FUNCTIONS
+//==============================================================================
+
+/**
+ * @brief Push onto a wait list (critical section held)
+ */
+static void list_push(cf_co_t** head, cf_co_t* co)
+{
+    co->prev = NULL;
+    co->next = *head;
+    if (*head != NULL) {
+        (*head)->prev = co;
+    }
+    *head = co;
+}
+
+/**
+ * @brief Unlink from a wait list (critical section held)
+ */
+static void list_remove(cf_co_t** head, cf_co_t* co)
+{
+    if (co->prev != NULL) {
+        co->prev->next = co->next;
+    } else {
+        *head = co->next;
+    }
+    if (co->next != NULL) {
+        co->next->prev = co->prev;
+    }
+}
+
+/**
+ * @brief Link into the wheel slot of the deadline (critical section held)
+ */
+static void wheel_push(cf_co_t* co)
+{
+    // The deadline was computed before the step returned; never file it
+    // into a slot that has already been swept
+    if ((int32_t)(co->deadline - g_sched.now) <= 0) {
+        co->deadline = g_sched.now + 1;
+    }
+
+    cf_co_t** head = &g_sched.wheel[co->deadline & (CO_WHEEL_SIZE - 1)];
+
+    co->time_prev = NULL;
+    co->time_next = *head;
+    if (*head != NULL) {
+        (*head)->time_prev = co;
+    }
+    *head = co;
+}
+
+/**
+ * @brief Unlink from the wheel (critical section held)
+ */
+static void wheel_remove(cf_co_t* co)
+{
+    if (co->time_prev != NULL) {
+        co->time_prev->time_next = co->time_next;
+    } else {
+        g_sched.wheel[co->deadline & (CO_WHEEL_SIZE - 1)] = co->time_next;
+    }
+    if (co->time_next != NULL) {
+        co->time_next->time_prev = co->time_prev;
+    }
+}
+
+/**
+ * @brief Wait list of the coroutines waiting on a queue
+ */
+static cf_co_t** queue_list(cf_queue_t queue)
+{
+    return &g_sched.queues[((uintptr_t)queue >> 4) & (CO_QUEUE_BUCKETS - 1)];
+}
+
+/**
+ * @brief Wait list of a suspended coroutine (critical section held)
+ */
+static cf_co_t** wait_list(cf_co_t* co)
+{
+    switch (co->wait_kind) {
+        case CO_WAIT_QUEUE:
+            return queue_list(co->wait.queue.queue);
+#if CF_EVENT_ENABLED
+        case CO_WAIT_EVENT:
+            return &g_sched.events[co->wait.event.id & (CO_EVENT_BUCKETS - 1)];
+#endif
+        default:
+            return NULL;
+    }
+}
+
+/**
+ * @brief Set the deadline of a wait
+ */
+static void arm_timeout(cf_co_t* co, uint32_t timeout_ms)
+{
+    if (timeout_ms == CF_WAIT_FOREVER) {
+        co->timed = false;
+        return;
+    }
+
+    uint32_t ticks = timeout_ms / CF_THREADPOOL_CO_TICK_MS +
+                     ((timeout_ms % CF_THREADPOOL_CO_TICK_MS) != 0 ? 1 : 0);
+    if (ticks == 0) {
+        ticks = 1;
+    } else if (ticks > CO_MAX_TICKS) {
+        ticks = CO_MAX_TICKS;
+    }
+
+    co->timed = true;
+    co->deadline = g_sched.now + ticks;
+}
+
+/**
+ * @brief Check whether the driver has nothing to do (critical section held)
+ */
+static bool sched_idle(void)
+{
+    if (g_sched.retry != NULL) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < CO_WHEEL_SIZE; i++) {
+        if (g_sched.wheel[i] != NULL) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Claim the start of a stopped driver (critical section held)
+ *
+ * Scheduler time stands still while the driver is stopped; deadlines are
+ * relative to it, so nothing is lost.
+ *
+ * @return true if the caller must call sched_start_driver() once out of the
+ *         critical section
+ */
+static bool sched_claim_driver(void)
+{
+    if (g_sched.driving) {
+        return false;
+    }
+
+    g_sched.driving = true;
+    g_sched.last_os_tick = (TickType_t)cf_time_get_tick_count();
+    return true;
+}
+
+/**
+ * @brief Start the driver after sched_claim_driver() (outside the critical section)
+ *
+ * If the timer command queue is full the claim is dropped, so that the
+ * next coroutine needing the driver tries again.
+ */
+static void sched_start_driver(void)
+{
+    if (cf_timer_start(g_sched.driver, 0) != CF_OK) {
+        cf_critical_section_enter();
+        g_sched.driving = false;
+        cf_critical_section_exit();
+    }
+}
+
+static void co_run(void* arg);
+
+/**
+ * @brief Discard hook: the pool dropped a step, which ends the coroutine
+ */
+static void co_discard(void* arg)
+{
+    cf_co_t* co = (cf_co_t*)arg;
+
+    cf_critical_section_enter();
+    co->status = CF_ERROR_CANCELLED;
+    co->state = CO_IDLE;
+    cf_critical_section_exit();
+}
+
+/**
+ * @brief Queue a step of a coroutine
+ *
+ * Steps are never run on the submitting task: that may be the timer
+ * service task or an event publisher holding the event module's lock.
+ */
+static cf_status_t co_submit(cf_co_t* co)
+{
+    cf_threadpool_job_t job = {
+        .function = co_run,
+        .arg = co,
+        .priority = (cf_threadpool_priority_t)co->priority,
+        .discard = co_discard,
+        .no_caller_runs = true
+    };
+
+    return cf_threadpool_submit_job(co->pool, &job, 0);
+}
+
+/**
+ * @brief Submit the next step of a coroutine
+ *
+ * The caller owns the coroutine: it is not linked anywhere.
+ */
+static void co_schedule(cf_co_t* co)
+{
+    co->state = CO_READY;
+
+    if (co_submit(co) != CF_OK) {
+        // Retried by the driver on its next tick
+        cf_critical_section_enter();
+        list_push(&g_sched.retry, co);
+        bool start = sched_claim_driver();
+        cf_critical_section_exit();
+
+        if (start) {
+            sched_start_driver();
+        }
+    }
+}
+
+/**
+ * @brief Schedule a chain of woken coroutines (linked through next)
+ */
+static void co_schedule_chain(cf_co_t* co)
+{
+    while (co != NULL) {
+        cf_co_t* next = co->next;
+        co_schedule(co);
+        co = next;
+    }
+}
+
+/**
+ * @brief Suspend a coroutine after its step armed a wait
+ *
+ * The caller owns the coroutine; only an event wait is linked already.
+ */
+static void co_suspend(cf_co_t* co)
+{
+    bool start = false;
+    bool ready = false;
+    cf_queue_t queue = NULL;
+
+    cf_critical_section_enter();
+    switch (co->wait_kind) {
+        case CO_WAIT_NONE:
+            ready = true;
+            break;
+
+        case CO_WAIT_DELIVER:
+            // The publisher schedules the coroutine once it has the payload
+            co->state = CO_WAITING;
+            break;
+
+        default:
+            co->state = CO_WAITING;
+            if (co->wait_kind == CO_WAIT_QUEUE) {
+                queue = co->wait.queue.queue;
+                list_push(queue_list(queue), co);
+            }
+            if (co->timed) {
+                wheel_push(co);
+                start = sched_claim_driver();
+            }
+            break;
+    }
+    cf_critical_section_exit();
+
+    if (start) {
+        sched_start_driver();
+    }
+
+    // An item sent before the coroutine was linked woke nobody
+    if (queue != NULL && !cf_queue_is_empty(queue)) {
+        (void)cf_co_wake_queue(queue);
+    }
+
+    if (ready) {
+        co_schedule(co);
+    }
+}
+
+#if CF_EVENT_ENABLED
+/**
+ * @brief Drop the event subscription once no coroutine waits for an event
+ *
+ * Called from steps only: publishers run the callback with the event
+ * module's lock held, so they cannot unsubscribe.
+ */
+static void event_release(void)
+{
+    cf_critical_section_enter();
+    bool release = g_sched.subscribed && !g_sched.subscribing && g_sched.event_waiters == 0;
+    if (release) {
+        g_sched.subscribing = true;
+    }
+    cf_critical_section_exit();
+
+    if (!release) {
+        return;
+    }
+
+    (void)cf_event_unsubscribe(g_sched.subscription);
+
+    cf_critical_section_enter();
+    g_sched.subscribed = false;
+    g_sched.subscribing = false;
+    cf_critical_section_exit();
+}
+#endif
+
+/**
+ * @brief Pool task running one coroutine step
+ */
+static void co_run(void* arg)
+{
+    cf_co_t* co = (cf_co_t*)arg;
+
+    co->state = CO_RUNNING;
+
+    if (co->wait_kind == CO_WAIT_QUEUE) {
+        // Woken by a producer: receive here rather than in its context. If
+        // another consumer was faster, wait again (the deadline is kept).
+        if (cf_queue_receive(co->wait.queue.queue, co->wait.queue.item, 0) != CF_OK) {
+            co_suspend(co);
+            return;
+        }
+        co->status = CF_OK;
+    }
+
+    co->wait_kind = CO_WAIT_NONE;
+    co->timed = false;
+
+    if (co->function(co, co->arg) == CF_CO_FINISHED) {
+        // After this the owner may restart or release the coroutine
+        cf_critical_section_enter();
+        co->state = CO_IDLE;
+        cf_critical_section_exit();
+    } else {
+        co_suspend(co);
+    }
+
+#if CF_EVENT_ENABLED
+    event_release();
+#endif
+}
+
+/**
+ * @brief Driver timer callback (timer service task)
+ */
+static void sched_tick(cf_timer_t timer, void* arg)
+{
+    (void)timer;
+    (void)arg;
+
+    TickType_t now = (TickType_t)cf_time_get_tick_count();
+
+    for (;;) {
+        cf_co_t* woken = NULL;
+
+        cf_critical_section_enter();
+        if ((TickType_t)(now - g_sched.last_os_tick) < g_sched.tick_period) {
+            cf_critical_section_exit();
+            break;
+        }
+        g_sched.last_os_tick += g_sched.tick_period;
+        g_sched.now++;
+
+        // Expire sleeps and timeouts due in this slot
+        cf_co_t* co = g_sched.wheel[g_sched.now & (CO_WHEEL_SIZE - 1)];
+        while (co != NULL) {
+            cf_co_t* next = co->time_next;
+
+            if ((int32_t)(g_sched.now - co->deadline) >= 0) {
+                cf_co_t** list = wait_list(co);
+
+                wheel_remove(co);
+                if (list != NULL) {
+                    list_remove(list, co);
+                }
+#if CF_EVENT_ENABLED
+                if (co->wait_kind == CO_WAIT_EVENT) {
+                    g_sched.event_waiters--;
+                }
+#endif
+                co->status = (co->wait_kind == CO_WAIT_SLEEP) ? CF_OK : CF_ERROR_TIMEOUT;
+                co->wait_kind = CO_WAIT_NONE;
+                co->next = woken;
+                woken = co;
+            }
+
+            co = next;
+        }
+
+        // Steps that found the pool queue full
+        while (g_sched.retry != NULL) {
+            co = g_sched.retry;
+            list_remove(&g_sched.retry, co);
+            co->next = woken;
+            woken = co;
+        }
+        cf_critical_section_exit();
+
+        co_schedule_chain(woken);
+    }
+
+    // Nothing left to drive: stop until a coroutine needs the driver again
+    cf_critical_section_enter();
+    bool stop = sched_idle();
+    if (stop) {
+        g_sched.driving = false;
+    }
+    cf_critical_section_exit();
+
+    if (stop) {
+        (void)cf_timer_stop(g_sched.driver, 0);
+
+        // A start claimed before the stop command was queued would be
+        // cancelled by it; issue it again
+        cf_critical_section_enter();
+        bool restart = g_sched.driving;
+        cf_critical_section_exit();
+
+        if (restart) {
+            sched_start_driver();
+        }
+    }
+}
+
+/**
+ * @brief Set up the scheduler and start its driver on first use
+ */
+static cf_status_t sched_init(void)
+{
+    bool owner = false;
+
+    for (;;) {
+        cf_critical_section_enter();
+        if (g_sched.initialized) {
+            cf_critical_section_exit();
+            return CF_OK;
+        }
+        if (!g_sched.initializing) {
+            g_sched.initializing = true;
+            owner = true;
+        }
+        cf_critical_section_exit();
+
+        if (owner) {
+            break;
+        }
+
+        // Another task is creating the driver
+        cf_task_delay(1);
+    }
+
+    g_sched.tick_period = pdMS_TO_TICKS(CF_THREADPOOL_CO_TICK_MS);
+    if (g_sched.tick_period == 0) {
+        g_sched.tick_period = 1;
+    }
+    g_sched.last_os_tick = (TickType_t)cf_time_get_tick_count();
+
+    cf_timer_config_t config;
+    cf_timer_config_default(&config);
+    config.name = "tp_co";
+    config.period_ms = CF_THREADPOOL_CO_TICK_MS;
+    config.type = CF_TIMER_PERIODIC;
+    config.callback = sched_tick;
+    config.auto_start = false;
+
+    cf_status_t status = cf_timer_create(&g_sched.driver, &config);
+
+    cf_critical_section_enter();
+    g_sched.initialized = (status == CF_OK);
+    g_sched.initializing = false;
+    cf_critical_section_exit();
+
+    return status;
+}
+
+#if CF_EVENT_ENABLED
+/**
+ * @brief Wake the coroutines waiting for an event (publisher context)
+ *
+ * Waiters are linked as soon as their step arms the wait, so a waiter may
+ * still be running its step. It is claimed first (CO_WAIT_DELIVER), given
+ * the payload outside the lock, and only then handed back: scheduled here
+ * if its step has returned, otherwise by the step's co_suspend().
+ */
+static void event_callback(cf_event_id_t event_id,
+                           const void* data,
+                           size_t data_size,
+                           void* user_data)
+{
+    (void)user_data;
+
+    cf_co_t* claimed = NULL;
+
+    cf_critical_section_enter();
+    cf_co_t** list = &g_sched.events[event_id & (CO_EVENT_BUCKETS - 1)];
+    cf_co_t* co = *list;
+    while (co != NULL) {
+        cf_co_t* next = co->next;
+
+        if (co->wait.event.id == event_id) {
+            list_remove(list, co);
+            g_sched.event_waiters--;
+            if (co->state == CO_WAITING && co->timed) {
+                wheel_remove(co);
+            }
+            co->wait_kind = CO_WAIT_DELIVER;
+            co->timed = false;
+            co->next = claimed;
+            claimed = co;
+        }
+
+        co = next;
+    }
+    cf_critical_section_exit();
+
+    if (claimed == NULL) {
+        return;
+    }
+
+    // Claimed coroutines belong to this task; copy outside the lock
+    for (co = claimed; co != NULL; co = co->next) {
+        size_t copy = (data_size < co->wait.event.size) ? data_size : co->wait.event.size;
+
+        if (co->wait.event.data == NULL || data == NULL) {
+            copy = 0;
+        }
+        if (copy > 0) {
+            memcpy(co->wait.event.data, data, copy);
+        }
+        co->wait.event.size = copy;
+        co->status = CF_OK;
+    }
+
+    cf_co_t* woken = NULL;
+
+    cf_critical_section_enter();
+    co = claimed;
+    while (co != NULL) {
+        cf_co_t* next = co->next;
+
+        if (co->state == CO_WAITING) {
+            co->next = woken;
+            woken = co;
+        } else {
+            // Step still returning: its co_suspend() schedules it
+            co->wait_kind = CO_WAIT_NONE;
+        }
+
+        co = next;
+    }
+    cf_critical_section_exit();
+
+    co_schedule_chain(woken);
+}
+
+/**
+ * @brief Link an event waiter, subscribing to the event system if needed
+ *
+ * The wildcard subscription is held only while coroutines wait for events
+ * (see event_release()), so publishers pay for it only then.
+ */
+static cf_status_t event_link(cf_co_t* co)
+{
+    for (;;) {
+        bool owner = false;
+
+        cf_critical_section_enter();
+        if (g_sched.subscribed && !g_sched.subscribing) {
+            list_push(&g_sched.events[co->wait.event.id & (CO_EVENT_BUCKETS - 1)], co);
+            g_sched.event_waiters++;
+            cf_critical_section_exit();
+            return CF_OK;
+        }
+        if (!g_sched.subscribing) {
+            g_sched.subscribing = true;
+            owner = true;
+        }
+        cf_critical_section_exit();
+
+        if (!owner) {
+            // Another step is subscribing or unsubscribing
+            cf_task_delay(1);
+            continue;
+        }
+
+        // Wildcard subscription: one subscriber slot for any number of waiters
+        cf_status_t status = cf_event_subscribe(0, event_callback, NULL, CF_EVENT_SYNC,
+                                                &g_sched.subscription);
+
+        cf_critical_section_enter();
+        g_sched.subscribed = (status == CF_OK);
+        g_sched.subscribing = false;
+        cf_critical_section_exit();
+
+        if (status != CF_OK) {
+            return status;
+        }
+    }
+}
+#endif
+
+//==============================================================================
+// PUBLIC API IMPLEMENTATION
+//==============================================================================
+
+cf_status_t cf_co_start(cf_co_t* co,
+                        cf_threadpool_t pool,
+                        cf_co_func_t function,
+                        void* arg,
+                        cf_threadpool_priority_t priority)
+{
+    CF_PTR_CHECK(co);
+    CF_PTR_CHECK(function);
+
+    if (pool == NULL) {
+        pool = cf_threadpool_get_default();
+        if (pool == NULL) {
+            return CF_ERROR_NOT_INITIALIZED;
+        }
+    }
+
+    cf_status_t status = sched_init();
+    if (status != CF_OK) {
+        return status;
+    }
+
+    memset(co, 0, sizeof(cf_co_t));
+    co->function = function;
+    co->arg = arg;
+    co->pool = pool;
+    co->priority = (uint8_t)priority;
+    co->status = CF_OK;
+    co->state = CO_READY;
+
+    status = co_submit(co);
+    if (status != CF_OK) {
+        co->state = CO_IDLE;
+    }
+
+    return status;
+}
+
+bool cf_co_is_done(const cf_co_t* co)
+{
+    if (co == NULL) {
+        return true;
+    }
+
+    cf_critical_section_enter();
+    bool done = (co->state == CO_IDLE);
+    cf_critical_section_exit();
+
+    return done;
+}
+
+void cf_co_yield(cf_co_t* co)
+{
+    co->wait_kind = CO_WAIT_NONE;
+    co->timed = false;
+    co->status = CF_OK;
+}
+
+void cf_co_sleep(cf_co_t* co, uint32_t ms)
+{
+    if (ms == 0 || ms == CF_WAIT_FOREVER) {
+        // Nothing could end an endless sleep, and it would keep the driver
+        // ticking; resume at once instead
+        cf_co_yield(co);
+        co->status = (ms == 0) ? CF_OK : CF_ERROR_INVALID_PARAM;
+        return;
+    }
+
+    co->status = CF_OK;
+    co->wait_kind = CO_WAIT_SLEEP;
+    arm_timeout(co, ms);
+}
+
+bool cf_co_await_queue(cf_co_t* co, cf_queue_t queue, void* item, uint32_t timeout_ms)
+{
+    if (queue == NULL || item == NULL) {
+        co->status = CF_ERROR_NULL_POINTER;
+        return true;
+    }
+
+    if (cf_queue_receive(queue, item, 0) == CF_OK) {
+        co->status = CF_OK;
+        return true;
+    }
+
+    if (timeout_ms == 0) {
+        co->status = CF_ERROR_TIMEOUT;
+        return true;
+    }
+
+    co->wait_kind = CO_WAIT_QUEUE;
+    co->wait.queue.queue = queue;
+    co->wait.queue.item = item;
+    arm_timeout(co, timeout_ms);
+
+    return false;
+}
+
+bool cf_co_wake_queue(cf_queue_t queue)
+{
+    if (queue == NULL || !g_sched.initialized) {
+        return false;
+    }
+
+    // Wake the longest waiting coroutine; its step receives the item
+    cf_critical_section_enter();
+    cf_co_t** list = queue_list(queue);
+    cf_co_t* oldest = NULL;
+    for (cf_co_t* co = *list; co != NULL; co = co->next) {
+        if (co->wait.queue.queue == queue) {
+            oldest = co;
+        }
+    }
+    if (oldest != NULL) {
+        list_remove(list, oldest);
+        if (oldest->timed) {
+            wheel_remove(oldest);
+        }
+    }
+    cf_critical_section_exit();
+
+    if (oldest == NULL) {
+        return false;
+    }
+
+    co_schedule(oldest);
+    return true;
+}
+
+cf_status_t cf_co_queue_send(cf_queue_t queue, const void* item, uint32_t timeout_ms)
+{
+    cf_status_t status = cf_queue_send(queue, item, timeout_ms);
+
+    if (status == CF_OK) {
+        (void)cf_co_wake_queue(queue);
+    }
+
+    return status;
+}
+
+#if CF_EVENT_ENABLED
+bool cf_co_await_event(cf_co_t* co,
+                       cf_event_id_t event_id,
+                       void* data,
+                       size_t size,
+                       uint32_t timeout_ms)
+{
+    co->wait.event.size = 0;
+
+    if (timeout_ms == 0) {
+        co->status = CF_ERROR_TIMEOUT;
+        return true;
+    }
+
+    co->wait_kind = CO_WAIT_EVENT;
+    co->wait.event.id = event_id;
+    co->wait.event.data = data;
+    co->wait.event.size = size;
+    arm_timeout(co, timeout_ms);
+
+    // Linked right away: events published while the step returns are seen
+    cf_status_t status = event_link(co);
+    if (status != CF_OK) {
+        co->wait_kind = CO_WAIT_NONE;
+        co->timed = false;
+        co->wait.event.size = 0;
+        co->status = status;
+        return true;
+    }
+
+    return false;
+}
+#endif
+
+#endif /* CF_THREADPOOL_ENABLED && CF_RTOS_ENABLED */
@@ -0,0 +1,351 @@
+/**
+ * @file cf_threadpool_co.h
+ * @brief Stackless coroutines on the ThreadPool
+ * @version 1.0.0
+ * @date 2025-11-20
+ * @author CFramework Contributors
+ *
+ * @copyright Copyright (c) 2025 CFramework
+ * Licensed under MIT License
+ *
+ * @description
+ * A coroutine is a protothread-style function: its body sits between
+ * CF_CO_BEGIN() and CF_CO_END(), and each wait macro (CF_CO_SLEEP(),
+ * CF_CO_AWAIT_QUEUE(), CF_CO_AWAIT_EVENT(), CF_CO_YIELD()) returns to the
+ * pool worker, which runs other jobs meanwhile. Once the wait is over the
+ * next step is submitted to the pool again and resumes after the macro.
+ * A suspended coroutine costs only its cf_co_t, so thousands of state
+ * machines can share a few worker stacks.
+ *
+ * Protothread rules apply: local variables do not survive a wait (keep
+ * state behind arg), waits cannot be used in functions called from the
+ * body, a switch statement must not contain a wait, and there can be at
+ * most one wait per source line.
+ *
+ * Sleeps and timeouts have a resolution of CF_THREADPOOL_CO_TICK_MS. FreeRTOS
+ * queues cannot notify waiters, so producers feed awaited queues through
+ * cf_co_queue_send() (or call cf_co_wake_queue() after sending), which
+ * wakes one waiting coroutine at once; nothing polls the queues. Awaited
+ * events wake their coroutines immediately.
+ *
+ * @code
+ * static cf_co_result_t blink(cf_co_t* co, void* arg)
+ * {
+ *     led_t* led = (led_t*)arg;
+ *
+ *     CF_CO_BEGIN(co);
+ *     for (;;) {
+ *         CF_CO_AWAIT_QUEUE(co, led->commands, &led->cmd, 1000);
+ *         if (CF_CO_STATUS(co) == CF_OK) {
+ *             led_apply(led);
+ *         }
+ *         CF_CO_SLEEP(co, 50);
+ *     }
+ *     CF_CO_END(co);
+ * }
+ * @endcode
+ */
+
+#ifndef CF_THREADPOOL_CO_H
+#define CF_THREADPOOL_CO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cf_common.h"
+
+#include "os/cf_queue.h"
+#include "threadpool/cf_threadpool.h"
+
+#if CF_EVENT_ENABLED
+    #include "event/cf_event.h"
+#endif
+
+#if CF_THREADPOOL_ENABLED && CF_RTOS_ENABLED
+
+//==============================================================================
+// TYPE DEFINITIONS
+//==============================================================================
+
+/**
+ * @brief Coroutine
+ */
+typedef struct cf_co_s cf_co_t;
+
+/**
+ * @brief Coroutine step result (returned by the CF_CO_* macros)
+ */
+typedef enum {
+    CF_CO_SUSPENDED = 0,        /**< Waiting; resumed later */
+    CF_CO_FINISHED              /**< Reached CF_CO_END() */
+} cf_co_result_t;
+
+/**
+ * @brief Coroutine function
+ *
+ * Runs one step, from the last wait to the next one.
+ */
+typedef cf_co_result_t (*cf_co_func_t)(cf_co_t* co, void* arg);
+
+/**
+ * @brief Coroutine state
+ *
+ * Defined here so that coroutines can be embedded in other structures or
+ * allocated statically; the fields are private. The memory must stay valid
+ * until cf_co_is_done() returns true.
+ */
+struct cf_co_s {
+    cf_co_t* next;              /**< Wait list link */
+    cf_co_t* prev;
+    cf_co_t* time_next;         /**< Timeout wheel link */
+    cf_co_t* time_prev;
+
+    cf_co_func_t function;
+    void* arg;
+    cf_threadpool_t pool;
+
+    uint32_t deadline;          /**< Scheduler tick the wait ends at */
+    union {
+        struct {
+            cf_queue_t queue;
+            void* item;
+        } queue;
+        struct {
+            void* data;
+            size_t size;        /**< Buffer size, then bytes received */
+            uint32_t id;
+        } event;
+    } wait;
+
+    cf_status_t status;         /**< Result of the last wait */
+    uint16_t line;              /**< Resume point */
+    uint8_t state;
+    uint8_t wait_kind;
+    uint8_t priority;
+    bool timed;                 /**< Linked into the timeout wheel */
+};
+
+//==============================================================================
+// COROUTINE BODY MACROS
+//==============================================================================
+
+/**
+ * @brief Start of a coroutine body
+ */
+#define CF_CO_BEGIN(co)                                                     \
+    switch ((co)->line) {                                                   \
+    case 0:
+
+/**
+ * @brief End of a coroutine body; the coroutine finishes here
+ */
+#define CF_CO_END(co)                                                       \
+    }                                                                       \
+    (co)->line = 0;                                                         \
+    return CF_CO_FINISHED
+
+/**
+ * @brief Return to the worker and resume here once the armed wait is over
+ * @note Internal, used by the wait macros below
+ */
+#define CF_CO_SUSPEND_(co)                                                  \
+    do {                                                                    \
+        (co)->line = (uint16_t)__LINE__;                                    \
+        return CF_CO_SUSPENDED;                                             \
+    case __LINE__:;                                                         \
+    } while (0)
+
+/**
+ * @brief Let other pool jobs run, then continue
+ */
+#define CF_CO_YIELD(co)                                                     \
+    do {                                                                    \
+        cf_co_yield(co);                                                    \
+        CF_CO_SUSPEND_(co);                                                 \
+    } while (0)
+
+/**
+ * @brief Suspend for ms milliseconds
+ *
+ * CF_WAIT_FOREVER is rejected: the coroutine resumes at once with
+ * CF_CO_STATUS() set to CF_ERROR_INVALID_PARAM. Finish the coroutine
+ * instead of sleeping forever.
+ */
+#define CF_CO_SLEEP(co, ms)                                                 \
+    do {                                                                    \
+        cf_co_sleep((co), (ms));                                            \
+        CF_CO_SUSPEND_(co);                                                 \
+    } while (0)
+
+/**
+ * @brief Receive an item from a queue, suspending while it is empty
+ *
+ * CF_CO_STATUS() is CF_OK once the item has been copied to item, or
+ * CF_ERROR_TIMEOUT. item must stay valid across the wait. Only items sent
+ * with cf_co_queue_send() or followed by cf_co_wake_queue() end the wait
+ * before the timeout.
+ */
+#define CF_CO_AWAIT_QUEUE(co, queue, item, timeout_ms)                      \
+    do {                                                                    \
+        if (!cf_co_await_queue((co), (queue), (item), (timeout_ms))) {      \
+            CF_CO_SUSPEND_(co);                                             \
+        }                                                                   \
+    } while (0)
+
+#if CF_EVENT_ENABLED
+/**
+ * @brief Suspend until an event is published
+ *
+ * CF_CO_STATUS() is CF_OK when the event arrived, with up to size bytes of
+ * its payload copied to data (may be NULL) and the copied length in
+ * CF_CO_EVENT_SIZE(); otherwise CF_ERROR_TIMEOUT or a subscription error.
+ * The wait starts when the macro is reached; events published before that
+ * are not seen.
+ */
+#define CF_CO_AWAIT_EVENT(co, event_id, data, size, timeout_ms)             \
+    do {                                                                    \
+        if (!cf_co_await_event((co), (event_id), (data), (size), (timeout_ms))) { \
+            CF_CO_SUSPEND_(co);                                             \
+        }                                                                   \
+    } while (0)
+
+/**
+ * @brief Payload bytes copied by the last CF_CO_AWAIT_EVENT()
+ */
+#define CF_CO_EVENT_SIZE(co)    ((co)->wait.event.size)
+#endif
+
+/**
+ * @brief Result of the last wait
+ */
+#define CF_CO_STATUS(co)        ((co)->status)
+
+//==============================================================================
+// PUBLIC API
+//==============================================================================
+
+/**
+ * @brief Start a coroutine
+ *
+ * Submits the first step to the pool. The function is then called once per
+ * step until it reaches CF_CO_END().
+ *
+ * @param[in] co Coroutine storage
+ * @param[in] pool Pool the steps run on (NULL = default instance)
+ * @param[in] function Coroutine function
+ * @param[in] arg Argument passed to every step
+ * @param[in] priority Priority of the steps
+ *
+ * @return CF_OK on success
+ * @return CF_ERROR_NULL_POINTER if co or function is NULL
+ * @return CF_ERROR_NOT_INITIALIZED if the pool is not initialized
+ * @return CF_ERROR_NO_MEMORY if the scheduler timer could not be created
+ * @return Other errors from cf_threadpool_submit_job() (the coroutine is
+ *         then not started; a full pool is reported, never run around)
+ *
+ * @note This function is thread-safe
+ * @warning co must not be started again before cf_co_is_done() returns true
+ */
+cf_status_t cf_co_start(cf_co_t* co,
+                        cf_threadpool_t pool,
+                        cf_co_func_t function,
+                        void* arg,
+                        cf_threadpool_priority_t priority);
+
+/**
+ * @brief Check whether a coroutine has finished (or was never started)
+ *
+ * A coroutine whose step the pool dropped (e.g. because the pool was
+ * destroyed without waiting) ends there; CF_CO_STATUS() then reads
+ * CF_ERROR_CANCELLED.
+ *
+ * @param[in] co Coroutine
+ *
+ * @return true if the coroutine is not running or waiting (or co is NULL)
+ *
+ * @note This function is thread-safe
+ */
+bool cf_co_is_done(const cf_co_t* co);
+
+/**
+ * @brief Arm a yield
+ * @note Use CF_CO_YIELD() instead
+ */
+void cf_co_yield(cf_co_t* co);
+
+/**
+ * @brief Arm a sleep
+ * @note Use CF_CO_SLEEP() instead
+ */
+void cf_co_sleep(cf_co_t* co, uint32_t ms);
+
+/**
+ * @brief Receive from a queue or arm the wait for it
+ *
+ * @return true if the wait is already over (item received, or timeout_ms
+ *         is 0), false if the coroutine must suspend
+ *
+ * @note Use CF_CO_AWAIT_QUEUE() instead
+ */
+bool cf_co_await_queue(cf_co_t* co, cf_queue_t queue, void* item, uint32_t timeout_ms);
+
+/**
+ * @brief Wake one coroutine waiting on a queue
+ *
+ * Call after sending to a queue that coroutines await. The coroutine that
+ * has waited longest resumes on the pool and receives the item there; if
+ * another consumer took it first, the coroutine keeps waiting.
+ *
+ * @param[in] queue Queue an item was sent to
+ *
+ * @return true if a waiting coroutine was woken
+ *
+ * @note This function is thread-safe
+ * @note Not for use from ISR
+ */
+bool cf_co_wake_queue(cf_queue_t queue);
+
+/**
+ * @brief Send to a queue and wake one coroutine waiting on it
+ *
+ * @param[in] queue Queue handle
+ * @param[in] item Item to copy into the queue
+ * @param[in] timeout_ms Timeout in milliseconds (0 = no wait)
+ *
+ * @return See cf_queue_send()
+ *
+ * @note This function is thread-safe
+ * @note Not for use from ISR
+ */
+cf_status_t cf_co_queue_send(cf_queue_t queue, const void* item, uint32_t timeout_ms);
+
+#if CF_EVENT_ENABLED
+/**
+ * @brief Arm the wait for an event
+ *
+ * @return true if the wait is already over (timeout_ms is 0, or the event
+ *         system could not be subscribed to), false if the coroutine must
+ *         suspend
+ *
+ * The coroutine is linked as a waiter before this returns. A synchronous
+ * wildcard subscription is held while any coroutine waits for an event
+ * and dropped by the step that finds no waiter left.
+ *
+ * @note Use CF_CO_AWAIT_EVENT() instead
+ * @note The event system must stay initialized while coroutines wait on it
+ */
+bool cf_co_await_event(cf_co_t* co,
+                       cf_event_id_t event_id,
+                       void* data,
+                       size_t size,
+                       uint32_t timeout_ms);
+#endif
+
+#endif /* CF_THREADPOOL_ENABLED && CF_RTOS_ENABLED */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CF_THREADPOOL_CO_H */
@@ -0,0 +1,302 @@
+/**
+ * @file cf_threadpool_future.c
+ * @brief ThreadPool completion handles (futures) implementation
+ */
+
+#include "threadpool/cf_threadpool_future.h"
+
+#if CF_THREADPOOL_ENABLED && CF_RTOS_ENABLED
+
+#include "cf_assert.h"
+#include "os/cf_critical.h"
+#include "os/cf_time.h"
+
+// Include FreeRTOS task API for waiter notifications
+#ifdef ESP_PLATFORM
+    #include "freertos/FreeRTOS.h"
+    #include "freertos/task.h"
+#else
+    #include "FreeRTOS.h"
+    #include "task.h"
+#endif
+
+#include <string.h>
+
+//==============================================================================
+// PRIVATE TYPES
+//==============================================================================
+
+/**
+ * @brief Completion handle slot
+ *
+ * A slot is referenced by the user (until release) and by the in-flight
+ * task (until completion); it returns to the pool when both are gone.
+ */
+struct cf_threadpool_future_s {
+    uint8_t refs;                           /**< 0 = free slot */
+    volatile bool done;
+    cf_status_t result;                     /**< CF_OK, or CF_ERROR_CANCELLED if dropped (valid once done) */
+    TaskHandle_t waiter;                    /**< Task blocked in wait(), if any */
+    cf_threadpool_t pool;                   /**< Pool the task (and continuation) runs on */
+
+    // Task to run
+    cf_threadpool_task_func_t function;
+    void* arg;
+
+    // Continuation
+    cf_threadpool_task_func_t then_function;
+    void* then_arg;
+    cf_threadpool_priority_t then_priority;
+};
+
+//==============================================================================
+// PRIVATE VARIABLES
+//==============================================================================
+
+static struct cf_threadpool_future_s g_futures[CF_THREADPOOL_FUTURE_POOL_SIZE];
+
+//==============================================================================
+// PRIVATE FUNCTIONS
+//==============================================================================
+
+/**
+ * @brief Allocate a slot from the pool
+ */
+static struct cf_threadpool_future_s* future_alloc(void)
+{
+    struct cf_threadpool_future_s* future = NULL;
+
+    cf_critical_section_enter();
+    for (uint32_t i = 0; i < CF_THREADPOOL_FUTURE_POOL_SIZE; i++) {
+        if (g_futures[i].refs == 0) {
+            future = &g_futures[i];
+            memset(future, 0, sizeof(*future));
+            future->refs = 2;   // user + in-flight task
+            break;
+        }
+    }
+    cf_critical_section_exit();
+
+    return future;
+}
+
+/**
+ * @brief Drop one reference (slot returns to the pool at zero)
+ */
+static void future_unref(struct cf_threadpool_future_s* future)
+{
+    cf_critical_section_enter();
+    future->refs--;
+    cf_critical_section_exit();
+}
+
+/**
+ * @brief Submit a continuation, running it inline if the pool is full
+ */
+static void run_continuation(cf_threadpool_t pool,
+                             cf_threadpool_task_func_t function,
+                             void* arg,
+                             cf_threadpool_priority_t priority)
+{
+    if (cf_threadpool_submit_to(pool, function, arg, priority, 0) != CF_OK) {
+        function(arg);
+    }
+}
+
+/**
+ * @brief Publish the outcome, wake the waiter and drop the in-flight reference
+ *
+ * The continuation is dispatched only if the task ran.
+ */
+static void future_complete(struct cf_threadpool_future_s* future, cf_status_t result)
+{
+    // Take over the waiter and continuation
+    cf_critical_section_enter();
+    future->result = result;
+    future->done = true;
+    TaskHandle_t waiter = future->waiter;
+    future->waiter = NULL;
+    cf_threadpool_task_func_t then_function = future->then_function;
+    void* then_arg = future->then_arg;
+    cf_threadpool_priority_t then_priority = future->then_priority;
+    cf_critical_section_exit();
+
+    if (waiter != NULL) {
+        xTaskNotifyGive(waiter);
+    }
+
+    if (then_function != NULL && result == CF_OK) {
+        run_continuation(future->pool, then_function, then_arg, then_priority);
+    }
+
+    future_unref(future);
+}
+
+/**
+ * @brief Pool task wrapping the user function
+ */
+static void future_trampoline(void* arg)
+{
+    struct cf_threadpool_future_s* future = (struct cf_threadpool_future_s*)arg;
+
+    future->function(future->arg);
+    future_complete(future, CF_OK);
+}
+
+/**
+ * @brief Discard hook: the pool dropped the task without running it
+ */
+static void future_discard(void* arg)
+{
+    future_complete((struct cf_threadpool_future_s*)arg, CF_ERROR_CANCELLED);
+}
+
+//==============================================================================
+// PUBLIC API IMPLEMENTATION
+//==============================================================================
+
+cf_status_t cf_threadpool_submit_future(cf_threadpool_task_func_t function,
+                                         void* arg,
+                                         cf_threadpool_priority_t priority,
+                                         uint32_t timeout_ms,
+                                         cf_threadpool_future_t* future)
+{
+    return cf_threadpool_submit_future_to(NULL, function, arg, priority, timeout_ms, future);
+}
+
+cf_status_t cf_threadpool_submit_future_to(cf_threadpool_t pool,
+                                            cf_threadpool_task_func_t function,
+                                            void* arg,
+                                            cf_threadpool_priority_t priority,
+                                            uint32_t timeout_ms,
+                                            cf_threadpool_future_t* future)
+{
+    CF_PTR_CHECK(future);
+    *future = NULL;
+    CF_PTR_CHECK(function);
+
+    struct cf_threadpool_future_s* f = future_alloc();
+    if (f == NULL) {
+        return CF_ERROR_NO_RESOURCE;
+    }
+
+    f->function = function;
+    f->arg = arg;
+    f->pool = pool;
+
+    cf_threadpool_job_t job = {
+        .function = future_trampoline,
+        .arg = f,
+        .priority = priority,
+        .discard = future_discard
+    };
+
+    cf_status_t status = cf_threadpool_submit_job(pool, &job, timeout_ms);
+    if (status != CF_OK) {
+        cf_critical_section_enter();
+        f->refs = 0;
+        cf_critical_section_exit();
+        return status;
+    }
+
+    *future = f;
+    return CF_OK;
+}
+
+bool cf_threadpool_future_is_done(cf_threadpool_future_t future)
+{
+    if (future == NULL) {
+        return false;
+    }
+
+    return future->done;
+}
+
+cf_status_t cf_threadpool_future_wait(cf_threadpool_future_t future, uint32_t timeout_ms)
+{
+    CF_PTR_CHECK(future);
+
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    uint32_t start_tick = cf_time_get_tick_count();
+
+    cf_critical_section_enter();
+    if (future->done) {
+        cf_critical_section_exit();
+        return future->result;
+    }
+    if (future->waiter != NULL && future->waiter != self) {
+        cf_critical_section_exit();
+        return CF_ERROR_BUSY;
+    }
+    future->waiter = self;
+    cf_critical_section_exit();
+
+    // Re-check after every wakeup: the notification value is shared
+    while (!future->done) {
+        TickType_t ticks = portMAX_DELAY;
+        if (timeout_ms != CF_WAIT_FOREVER) {
+            uint32_t elapsed = cf_time_elapsed_ms(start_tick);
+            if (elapsed >= timeout_ms) {
+                break;
+            }
+            ticks = pdMS_TO_TICKS(timeout_ms - elapsed);
+            if (ticks == 0) {
+                ticks = 1;
+            }
+        }
+
+        ulTaskNotifyTake(pdTRUE, ticks);
+    }
+
+    cf_critical_section_enter();
+    bool done = future->done;
+    if (future->waiter == self) {
+        future->waiter = NULL;
+    }
+    cf_critical_section_exit();
+
+    return done ? future->result : CF_ERROR_TIMEOUT;
+}
+
+cf_status_t cf_threadpool_future_then(cf_threadpool_future_t future,
+                                       cf_threadpool_task_func_t function,
+                                       void* arg,
+                                       cf_threadpool_priority_t priority)
+{
+    CF_PTR_CHECK(future);
+    CF_PTR_CHECK(function);
+
+    cf_critical_section_enter();
+    if (future->then_function != NULL) {
+        cf_critical_section_exit();
+        return CF_ERROR_IN_USE;
+    }
+    if (future->done && future->result != CF_OK) {
+        cf_critical_section_exit();
+        return future->result;
+    }
+
+    bool done = future->done;
+    future->then_function = function;
+    future->then_arg = arg;
+    future->then_priority = priority;
+    cf_critical_section_exit();
+
+    // Completed before the continuation was attached: dispatch it now
+    if (done) {
+        run_continuation(future->pool, function, arg, priority);
+    }
+
+    return CF_OK;
+}
+
+void cf_threadpool_future_release(cf_threadpool_future_t future)
+{
+    if (future == NULL) {
+        return;
+    }
+
+    future_unref(future);
+}
+
+#endif /* CF_THREADPOOL_ENABLED && CF_RTOS_ENABLED */
@@ -0,0 +1,163 @@
+/**
+ * @file cf_threadpool_future.h
+ * @brief ThreadPool completion handles (futures)
+ * @version 1.0.0
+ * @date 2025-11-20
+ * @author CFramework Contributors
+ *
+ * @copyright Copyright (c) 2025 CFramework
+ * Licensed under MIT License
+ */
+
+#ifndef CF_THREADPOOL_FUTURE_H
+#define CF_THREADPOOL_FUTURE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cf_common.h"
+
+#include "threadpool/cf_threadpool.h"
+
+#if CF_THREADPOOL_ENABLED && CF_RTOS_ENABLED
+
+//==============================================================================
+// TYPE DEFINITIONS
+//==============================================================================
+
+/**
+ * @brief Opaque completion handle
+ *
+ * Handles come from a fixed pool of CF_THREADPOOL_FUTURE_POOL_SIZE entries.
+ * A handle stays valid until cf_threadpool_future_release() is called, even
+ * after the task has completed.
+ */
+typedef struct cf_threadpool_future_s* cf_threadpool_future_t;
+
+//==============================================================================
+// PUBLIC API
+//==============================================================================
+
+/**
+ * @brief Submit task to ThreadPool and get a completion handle
+ *
+ * @param[in] function Task function to execute
+ * @param[in] arg Argument to pass to function
+ * @param[in] priority Task priority (for queue ordering)
+ * @param[in] timeout_ms Timeout in milliseconds (0 = no wait)
+ * @param[out] future Pointer to receive completion handle
+ *
+ * @return CF_OK on success
+ * @return CF_ERROR_NULL_POINTER if function or future is NULL
+ * @return CF_ERROR_NO_RESOURCE if all completion handles are in use
+ * @return Any error returned by cf_threadpool_submit_to()
+ *
+ * @note This function is thread-safe
+ * @note On failure no handle is allocated and *future is set to NULL
+ */
+cf_status_t cf_threadpool_submit_future(cf_threadpool_task_func_t function,
+                                         void* arg,
+                                         cf_threadpool_priority_t priority,
+                                         uint32_t timeout_ms,
+                                         cf_threadpool_future_t* future);
+
+/**
+ * @brief Submit task to a specific ThreadPool and get a completion handle
+ *
+ * Same as cf_threadpool_submit_future(); continuations attached with
+ * cf_threadpool_future_then() run on the same pool.
+ *
+ * @param[in] pool Pool handle (NULL = default instance)
+ *
+ * @return See cf_threadpool_submit_future()
+ */
+cf_status_t cf_threadpool_submit_future_to(cf_threadpool_t pool,
+                                            cf_threadpool_task_func_t function,
+                                            void* arg,
+                                            cf_threadpool_priority_t priority,
+                                            uint32_t timeout_ms,
+                                            cf_threadpool_future_t* future);
+
+/**
+ * @brief Check whether the task has completed
+ *
+ * @param[in] future Completion handle
+ *
+ * @return true if completed or dropped (see cf_threadpool_future_wait()),
+ *         false otherwise (or if future is NULL)
+ *
+ * @note This function is thread-safe and ISR-safe
+ */
+bool cf_threadpool_future_is_done(cf_threadpool_future_t future);
+
+/**
+ * @brief Wait for the task to complete
+ *
+ * The waiting task blocks on its task notification and is woken directly
+ * by the worker that completes the task.
+ *
+ * @param[in] future Completion handle
+ * @param[in] timeout_ms Timeout in milliseconds (CF_WAIT_FOREVER for infinite)
+ *
+ * @return CF_OK if the task has completed
+ * @return CF_ERROR_CANCELLED if the pool dropped the task without running
+ *         it (cancelled, or the pool was destroyed without waiting)
+ * @return CF_ERROR_NULL_POINTER if future is NULL
+ * @return CF_ERROR_BUSY if another task is already waiting on this handle
+ * @return CF_ERROR_TIMEOUT if timeout occurred
+ *
+ * @note This function is thread-safe
+ * @note Only one task may wait on a handle at a time
+ * @warning Uses the calling task's notification value; a task that also
+ *          uses ulTaskNotifyTake() for its own purposes may see a spurious
+ *          wakeup afterwards
+ */
+cf_status_t cf_threadpool_future_wait(cf_threadpool_future_t future, uint32_t timeout_ms);
+
+/**
+ * @brief Chain a continuation onto a task
+ *
+ * The continuation is submitted to the pool when the task completes, or
+ * immediately if it has already completed. If the pool queue is full at
+ * that moment, the continuation runs inline instead (on the completing
+ * worker, or in the caller if the task had already completed). It is not
+ * run if the pool drops the task.
+ *
+ * @param[in] future Completion handle
+ * @param[in] function Continuation function
+ * @param[in] arg Argument to pass to function
+ * @param[in] priority Continuation priority
+ *
+ * @return CF_OK on success
+ * @return CF_ERROR_NULL_POINTER if future or function is NULL
+ * @return CF_ERROR_IN_USE if a continuation is already attached
+ * @return CF_ERROR_CANCELLED if the task was dropped without running
+ *
+ * @note This function is thread-safe
+ * @note At most one continuation can be attached to a handle
+ */
+cf_status_t cf_threadpool_future_then(cf_threadpool_future_t future,
+                                       cf_threadpool_task_func_t function,
+                                       void* arg,
+                                       cf_threadpool_priority_t priority);
+
+/**
+ * @brief Release a completion handle
+ *
+ * The handle must not be used after this call. It may be released before
+ * the task has completed; the slot returns to the pool once it has.
+ *
+ * @param[in] future Completion handle (NULL is ignored)
+ *
+ * @note This function is thread-safe
+ */
+void cf_threadpool_future_release(cf_threadpool_future_t future);
+
+#endif /* CF_THREADPOOL_ENABLED && CF_RTOS_ENABLED */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CF_THREADPOOL_FUTURE_H */
@@ -0,0 +1,418 @@
+/**
+ * @file cf_threadpool_graph.c
+ * @brief ThreadPool task graph implementation
+ */
+
+#include "threadpool/cf_threadpool_graph.h"
+
+#if CF_THREADPOOL_ENABLED && CF_RTOS_ENABLED
+
+#include "cf_assert.h"
+#include "os/cf_alloc.h"
+#include "os/cf_atomic.h"
+#include "os/cf_critical.h"
+#include "os/cf_time.h"
+
+// Include FreeRTOS task API for waiter notifications
+#ifdef ESP_PLATFORM
+    #include "freertos/FreeRTOS.h"
+    #include "freertos/task.h"
+#else
+    #include "FreeRTOS.h"
+    #include "task.h"
+#endif
+
+#include <string.h>
+
+//==============================================================================
+// PRIVATE CONSTANTS
+//==============================================================================
+
+#define CF_THREADPOOL_GRAPH_NO_NODE UINT32_MAX  /**< End of a worklist */
+
+//==============================================================================
+// PRIVATE TYPES
+//==============================================================================
+
+/**
+ * @brief Graph node
+ */
+typedef struct {
+    struct cf_threadpool_graph_s* graph;
+    cf_threadpool_task_func_t function;
+    void* arg;
+    cf_threadpool_priority_t priority;
+
+    uint32_t predecessors;          /**< Incoming edges */
+    cf_atomic_u32_t pending;        /**< Predecessors not yet finished in this run */
+
+    uint32_t successor_count;
+    cf_threadpool_graph_node_t successors[CF_THREADPOOL_GRAPH_MAX_SUCCESSORS];
+
+    cf_threadpool_graph_node_t next_ready;  /**< Next node on a local worklist */
+} cf_threadpool_graph_node_s;
+
+/**
+ * @brief Task graph structure
+ */
+struct cf_threadpool_graph_s {
+    cf_threadpool_t pool;
+
+    cf_threadpool_graph_node_s* nodes;
+    uint32_t node_count;
+    uint32_t max_nodes;
+
+    uint32_t* order;                /**< Scratch queue for the cycle check */
+    bool validated;                 /**< Edges unchanged since the last check */
+
+    cf_atomic_u32_t remaining;      /**< Nodes not yet finished (0 = idle) */
+    cf_atomic_u32_t cancelled;      /**< The pool dropped a node of this run */
+    TaskHandle_t waiter;            /**< Task blocked in wait(), if any */
+};
+
+//==============================================================================
+// PRIVATE FUNCTIONS
+//==============================================================================
+
+static void node_trampoline(void* arg);
+static void node_discard(void* arg);
+
+/**
+ * @brief Queue a ready node (never run on the submitting task)
+ */
+static cf_status_t submit_node(cf_threadpool_graph_node_s* node)
+{
+    cf_threadpool_job_t job = {
+        .function = node_trampoline,
+        .arg = node,
+        .priority = node->priority,
+        .discard = node_discard,
+        .no_caller_runs = true
+    };
+
+    return cf_threadpool_submit_job(node->graph->pool, &job, 0);
+}
+
+/**
+ * @brief Release the successors of a finished node and account for it
+ *
+ * Successors the pool cannot take, and all of them once the run is
+ * cancelled, are pushed on the caller's worklist.
+ */
+static void finish_node(cf_threadpool_graph_node_s* node, cf_threadpool_graph_node_t* ready)
+{
+    struct cf_threadpool_graph_s* graph = node->graph;
+
+    // The last predecessor to finish releases a successor
+    for (uint32_t i = 0; i < node->successor_count; i++) {
+        cf_threadpool_graph_node_s* next = &graph->nodes[node->successors[i]];
+        if (cf_atomic_fetch_sub(&next->pending, 1) == 1 &&
+            (cf_atomic_load(&graph->cancelled) != 0 || submit_node(next) != CF_OK)) {
+            next->next_ready = *ready;
+            *ready = node->successors[i];
+        }
+    }
+
+    // Finishing the run and taking over the waiter happen together, so a
+    // waiter that sees the run finished may destroy the graph right away
+    cf_critical_section_enter();
+    TaskHandle_t waiter = NULL;
+    if (cf_atomic_fetch_sub(&graph->remaining, 1) == 1) {
+        waiter = graph->waiter;
+        graph->waiter = NULL;
+    }
+    cf_critical_section_exit();
+
+    if (waiter != NULL) {
+        xTaskNotifyGive(waiter);
+    }
+}
+
+/**
+ * @brief Run a node and every node left on the worklist it produces
+ *
+ * A loop rather than recursion, so a long chain run on one task while the
+ * pool is full needs constant stack. Nodes of a cancelled run are finished
+ * without calling their function.
+ */
+static void run_nodes(cf_threadpool_graph_node_s* node)
+{
+    struct cf_threadpool_graph_s* graph = node->graph;
+    cf_threadpool_graph_node_t ready = CF_THREADPOOL_GRAPH_NO_NODE;
+
+    // The graph may be gone once the worklist is empty after finish_node()
+    for (;;) {
+        if (cf_atomic_load(&graph->cancelled) == 0) {
+            node->function(node->arg);
+        }
+        finish_node(node, &ready);
+
+        if (ready == CF_THREADPOOL_GRAPH_NO_NODE) {
+            break;
+        }
+        node = &graph->nodes[ready];
+        ready = node->next_ready;
+    }
+}
+
+/**
+ * @brief Pool task wrapping a node function
+ */
+static void node_trampoline(void* arg)
+{
+    run_nodes((cf_threadpool_graph_node_s*)arg);
+}
+
+/**
+ * @brief Discard hook: the pool dropped a node, so the rest of the run is skipped
+ */
+static void node_discard(void* arg)
+{
+    cf_threadpool_graph_node_s* node = (cf_threadpool_graph_node_s*)arg;
+
+    cf_atomic_store(&node->graph->cancelled, 1);
+    run_nodes(node);
+}
+
+/**
+ * @brief Check that the edges form a DAG (Kahn's algorithm)
+ *
+ * Uses the pending counters as scratch; they are reset before every run.
+ */
+static bool graph_is_acyclic(struct cf_threadpool_graph_s* graph)
+{
+    uint32_t head = 0;
+    uint32_t tail = 0;
+
+    for (uint32_t i = 0; i < graph->node_count; i++) {
+        cf_atomic_store(&graph->nodes[i].pending, graph->nodes[i].predecessors);
+        if (graph->nodes[i].predecessors == 0) {
+            graph->order[tail++] = i;
+        }
+    }
+
+    while (head < tail) {
+        cf_threadpool_graph_node_s* node = &graph->nodes[graph->order[head++]];
+        for (uint32_t i = 0; i < node->successor_count; i++) {
+            cf_threadpool_graph_node_t next = node->successors[i];
+            if (cf_atomic_fetch_sub(&graph->nodes[next].pending, 1) == 1) {
+                graph->order[tail++] = next;
+            }
+        }
+    }
+
+    return tail == graph->node_count;
+}
+
+//==============================================================================
+// PUBLIC API IMPLEMENTATION
+//==============================================================================
+
+cf_status_t cf_threadpool_graph_create(cf_threadpool_graph_t* graph,
+                                        cf_threadpool_t pool,
+                                        uint32_t max_nodes)
+{
+    CF_PTR_CHECK(graph);
+    *graph = NULL;
+
+    if (max_nodes == 0) {
+        return CF_ERROR_INVALID_PARAM;
+    }
+
+    struct cf_threadpool_graph_s* g = (struct cf_threadpool_graph_s*)cf_alloc(sizeof(struct cf_threadpool_graph_s));
+    if (g == NULL) {
+        return CF_ERROR_NO_MEMORY;
+    }
+
+    memset(g, 0, sizeof(struct cf_threadpool_graph_s));
+    g->pool = pool;
+    g->max_nodes = max_nodes;
+
+    g->nodes = (cf_threadpool_graph_node_s*)cf_alloc(max_nodes * sizeof(cf_threadpool_graph_node_s));
+    g->order = (uint32_t*)cf_alloc(max_nodes * sizeof(uint32_t));
+    if (g->nodes == NULL || g->order == NULL) {
+        cf_threadpool_graph_destroy(g);
+        return CF_ERROR_NO_MEMORY;
+    }
+
+    memset(g->nodes, 0, max_nodes * sizeof(cf_threadpool_graph_node_s));
+
+    *graph = g;
+    return CF_OK;
+}
+
+void cf_threadpool_graph_destroy(cf_threadpool_graph_t graph)
+{
+    if (graph == NULL) {
+        return;
+    }
+
+    if (graph->order) cf_free(graph->order);
+    if (graph->nodes) cf_free(graph->nodes);
+    cf_free(graph);
+}
+
+cf_status_t cf_threadpool_graph_add_node(cf_threadpool_graph_t graph,
+                                          cf_threadpool_task_func_t function,
+                                          void* arg,
+                                          cf_threadpool_priority_t priority,
+                                          cf_threadpool_graph_node_t* node)
+{
+    CF_PTR_CHECK(graph);
+    CF_PTR_CHECK(function);
+
+    if (cf_atomic_load(&graph->remaining) != 0) {
+        return CF_ERROR_BUSY;
+    }
+
+    if (graph->node_count >= graph->max_nodes) {
+        return CF_ERROR_NO_RESOURCE;
+    }
+
+    cf_threadpool_graph_node_s* n = &graph->nodes[graph->node_count];
+    n->graph = graph;
+    n->function = function;
+    n->arg = arg;
+    n->priority = priority;
+
+    if (node != NULL) {
+        *node = graph->node_count;
+    }
+
+    graph->node_count++;
+
+    return CF_OK;
+}
+
+cf_status_t cf_threadpool_graph_add_edge(cf_threadpool_graph_t graph,
+                                          cf_threadpool_graph_node_t from,
+                                          cf_threadpool_graph_node_t to)
+{
+    CF_PTR_CHECK(graph);
+
+    if (from >= graph->node_count || to >= graph->node_count || from == to) {
+        return CF_ERROR_INVALID_PARAM;
+    }
+
+    if (cf_atomic_load(&graph->remaining) != 0) {
+        return CF_ERROR_BUSY;
+    }
+
+    cf_threadpool_graph_node_s* n = &graph->nodes[from];
+    if (n->successor_count >= CF_THREADPOOL_GRAPH_MAX_SUCCESSORS) {
+        return CF_ERROR_NO_RESOURCE;
+    }
+
+    n->successors[n->successor_count++] = to;
+    graph->nodes[to].predecessors++;
+    graph->validated = false;
+
+    return CF_OK;
+}
+
+cf_status_t cf_threadpool_graph_run(cf_threadpool_graph_t graph)
+{
+    CF_PTR_CHECK(graph);
+
+    if (graph->node_count == 0) {
+        return CF_OK;
+    }
+
+    // Claim the graph for this run
+    uint32_t idle = 0;
+    if (!cf_atomic_compare_exchange(&graph->remaining, &idle, graph->node_count)) {
+        return CF_ERROR_BUSY;
+    }
+
+    if (!graph->validated) {
+        if (!graph_is_acyclic(graph)) {
+            cf_atomic_store(&graph->remaining, 0);
+            return CF_ERROR_INVALID_PARAM;
+        }
+        graph->validated = true;
+    }
+
+    cf_atomic_store(&graph->cancelled, 0);
+
+    uint32_t roots = 0;
+    for (uint32_t i = 0; i < graph->node_count; i++) {
+        cf_atomic_store(&graph->nodes[i].pending, graph->nodes[i].predecessors);
+        if (graph->nodes[i].predecessors == 0) {
+            roots++;
+        }
+    }
+
+    // Once the last root is out the run may finish (and the graph be
+    // destroyed by its waiter), so stop touching it right there
+    for (uint32_t i = 0; roots > 0; i++) {
+        if (graph->nodes[i].predecessors == 0) {
+            roots--;
+            if (submit_node(&graph->nodes[i]) != CF_OK) {
+                run_nodes(&graph->nodes[i]);
+            }
+        }
+    }
+
+    return CF_OK;
+}
+
+cf_status_t cf_threadpool_graph_wait(cf_threadpool_graph_t graph, uint32_t timeout_ms)
+{
+    CF_PTR_CHECK(graph);
+
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    uint32_t start_tick = cf_time_get_tick_count();
+
+    cf_critical_section_enter();
+    if (cf_atomic_load(&graph->remaining) == 0) {
+        cf_critical_section_exit();
+        return (cf_atomic_load(&graph->cancelled) != 0) ? CF_ERROR_CANCELLED : CF_OK;
+    }
+    if (graph->waiter != NULL && graph->waiter != self) {
+        cf_critical_section_exit();
+        return CF_ERROR_BUSY;
+    }
+    graph->waiter = self;
+    cf_critical_section_exit();
+
+    // Re-check after every wakeup: the notification value is shared
+    while (cf_atomic_load(&graph->remaining) != 0) {
+        TickType_t ticks = portMAX_DELAY;
+        if (timeout_ms != CF_WAIT_FOREVER) {
+            uint32_t elapsed = cf_time_elapsed_ms(start_tick);
+            if (elapsed >= timeout_ms) {
+                break;
+            }
+            ticks = pdMS_TO_TICKS(timeout_ms - elapsed);
+            if (ticks == 0) {
+                ticks = 1;
+            }
+        }
+
+        ulTaskNotifyTake(pdTRUE, ticks);
+    }
+
+    cf_critical_section_enter();
+    bool done = (cf_atomic_load(&graph->remaining) == 0);
+    if (graph->waiter == self) {
+        graph->waiter = NULL;
+    }
+    cf_critical_section_exit();
+
+    if (!done) {
+        return CF_ERROR_TIMEOUT;
+    }
+
+    return (cf_atomic_load(&graph->cancelled) != 0) ? CF_ERROR_CANCELLED : CF_OK;
+}
+
+bool cf_threadpool_graph_is_running(cf_threadpool_graph_t graph)
+{
+    if (graph == NULL) {
+        return false;
+    }
+
+    return cf_atomic_load(&graph->remaining) != 0;
+}
+
+#endif /* CF_THREADPOOL_ENABLED && CF_RTOS_ENABLED */
@@ -0,0 +1,174 @@
+/**
+ * @file cf_threadpool_graph.h
+ * @brief ThreadPool task graph (static DAG executor)
+ * @version 1.0.0
+ * @date 2025-11-20
+ * @author CFramework Contributors
+ *
+ * @copyright Copyright (c) 2025 CFramework
+ * Licensed under MIT License
+ *
+ * @description
+ * A task graph is built once (nodes plus "runs after" edges) and can then be
+ * launched any number of times. Each launch submits the nodes without
+ * predecessors; every other node is submitted by whichever predecessor
+ * finishes last. Runs allocate nothing.
+ */
+
+#ifndef CF_THREADPOOL_GRAPH_H
+#define CF_THREADPOOL_GRAPH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cf_common.h"
+
+#include "threadpool/cf_threadpool.h"
+
+#if CF_THREADPOOL_ENABLED && CF_RTOS_ENABLED
+
+//==============================================================================
+// TYPE DEFINITIONS
+//==============================================================================
+
+/**
+ * @brief Opaque task graph handle
+ */
+typedef struct cf_threadpool_graph_s* cf_threadpool_graph_t;
+
+/**
+ * @brief Node identifier (index in order of cf_threadpool_graph_add_node())
+ */
+typedef uint32_t cf_threadpool_graph_node_t;
+
+//==============================================================================
+// PUBLIC API
+//==============================================================================
+
+/**
+ * @brief Create an empty task graph
+ *
+ * @param[out] graph Pointer to receive graph handle
+ * @param[in] pool Pool the nodes run on (NULL = default instance)
+ * @param[in] max_nodes Node capacity
+ *
+ * @return CF_OK on success
+ * @return CF_ERROR_NULL_POINTER if graph is NULL
+ * @return CF_ERROR_INVALID_PARAM if max_nodes is 0
+ * @return CF_ERROR_NO_MEMORY if allocation failed
+ *
+ * @note All memory is allocated here; running the graph allocates nothing
+ */
+cf_status_t cf_threadpool_graph_create(cf_threadpool_graph_t* graph,
+                                        cf_threadpool_t pool,
+                                        uint32_t max_nodes);
+
+/**
+ * @brief Destroy a task graph
+ *
+ * @param[in] graph Graph handle (NULL is ignored)
+ *
+ * @note The graph must not be running: wait for the last run with
+ *       cf_threadpool_graph_wait() first
+ */
+void cf_threadpool_graph_destroy(cf_threadpool_graph_t graph);
+
+/**
+ * @brief Add a node
+ *
+ * @param[in] graph Graph handle
+ * @param[in] function Task function to execute
+ * @param[in] arg Argument to pass to function
+ * @param[in] priority Priority the node is submitted with
+ * @param[out] node Pointer to receive node identifier (may be NULL)
+ *
+ * @return CF_OK on success
+ * @return CF_ERROR_NULL_POINTER if graph or function is NULL
+ * @return CF_ERROR_NO_RESOURCE if the graph is full
+ * @return CF_ERROR_BUSY if the graph is running
+ */
+cf_status_t cf_threadpool_graph_add_node(cf_threadpool_graph_t graph,
+                                          cf_threadpool_task_func_t function,
+                                          void* arg,
+                                          cf_threadpool_priority_t priority,
+                                          cf_threadpool_graph_node_t* node);
+
+/**
+ * @brief Add a dependency: node "to" runs after node "from" has finished
+ *
+ * @param[in] graph Graph handle
+ * @param[in] from Predecessor node
+ * @param[in] to Successor node
+ *
+ * @return CF_OK on success
+ * @return CF_ERROR_NULL_POINTER if graph is NULL
+ * @return CF_ERROR_INVALID_PARAM if a node does not exist or from == to
+ * @return CF_ERROR_NO_RESOURCE if "from" already has
+ *         CF_THREADPOOL_GRAPH_MAX_SUCCESSORS successors
+ * @return CF_ERROR_BUSY if the graph is running
+ *
+ * @note Cycles are detected by the next cf_threadpool_graph_run()
+ */
+cf_status_t cf_threadpool_graph_add_edge(cf_threadpool_graph_t graph,
+                                          cf_threadpool_graph_node_t from,
+                                          cf_threadpool_graph_node_t to);
+
+/**
+ * @brief Launch one run of the graph
+ *
+ * Submits every node without predecessors and returns. A node that cannot
+ * be queued because the pool is full runs inline instead (here, or on the
+ * worker that finished its last predecessor), so a run always completes.
+ * If the pool drops a queued node (e.g. it is destroyed without waiting),
+ * the nodes not yet started are skipped and the run ends as cancelled.
+ *
+ * @param[in] graph Graph handle
+ *
+ * @return CF_OK on success (also for an empty graph)
+ * @return CF_ERROR_NULL_POINTER if graph is NULL
+ * @return CF_ERROR_BUSY if the previous run has not finished
+ * @return CF_ERROR_INVALID_PARAM if the edges contain a cycle
+ *
+ * @note This function is thread-safe
+ */
+cf_status_t cf_threadpool_graph_run(cf_threadpool_graph_t graph);
+
+/**
+ * @brief Wait for the current run to finish
+ *
+ * @param[in] graph Graph handle
+ * @param[in] timeout_ms Timeout in milliseconds (CF_WAIT_FOREVER for infinite)
+ *
+ * @return CF_OK if no run is in progress
+ * @return CF_ERROR_CANCELLED if the last run ended with nodes skipped
+ * @return CF_ERROR_NULL_POINTER if graph is NULL
+ * @return CF_ERROR_BUSY if another task is already waiting on this graph
+ * @return CF_ERROR_TIMEOUT if timeout occurred
+ *
+ * @note This function is thread-safe
+ * @note Only one task may wait on a graph at a time
+ * @note Must not be called from a node of the same graph
+ * @warning Uses the calling task's notification value (see
+ *          cf_threadpool_future_wait())
+ */
+cf_status_t cf_threadpool_graph_wait(cf_threadpool_graph_t graph, uint32_t timeout_ms);
+
+/**
+ * @brief Check whether a run is in progress
+ *
+ * @param[in] graph Graph handle
+ *
+ * @return true if running, false otherwise (or if graph is NULL)
+ *
+ * @note This function is thread-safe and ISR-safe
+ */
+bool cf_threadpool_graph_is_running(cf_threadpool_graph_t graph);
+
+#endif /* CF_THREADPOOL_ENABLED && CF_RTOS_ENABLED */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CF_THREADPOOL_GRAPH_H */
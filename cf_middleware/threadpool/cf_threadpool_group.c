@@ -0,0 +1,322 @@
+/**
+ * @file cf_threadpool_group.c
+ * @brief ThreadPool task group implementation
+ */
+
+#include "threadpool/cf_threadpool_group.h"
+
+#if CF_THREADPOOL_ENABLED && CF_RTOS_ENABLED
+
+#include "cf_assert.h"
+#include "os/cf_alloc.h"
+#include "os/cf_atomic.h"
+#include "os/cf_critical.h"
+#include "os/cf_time.h"
+
+#ifdef ESP_PLATFORM
+    #include "freertos/FreeRTOS.h"
+    #include "freertos/task.h"
+#else
+    #include "FreeRTOS.h"
+    #include "task.h"
+#endif
+
+#include <string.h>
+
+//==============================================================================
+// PRIVATE FUNCTIONS
+//==============================================================================
+
+/**
+ * @brief Take the oldest waiting job
+ */
+static bool group_pop(struct cf_task_group_s* group, cf_task_group_job_t* job)
+{
+    bool found = false;
+
+    cf_critical_section_enter();
+    if (group->count > 0) {
+        *job = group->jobs[group->head];
+        group->head = (group->head + 1) % group->capacity;
+        group->count--;
+        found = true;
+    }
+    cf_critical_section_exit();
+
+    return found;
+}
+
+/**
+ * @brief Count down a finished job and wake the waiter after the last one
+ */
+static void group_finish(struct cf_task_group_s* group)
+{
+    if (cf_atomic_fetch_sub(&group->pending, 1) != 1) {
+        return;
+    }
+
+    cf_critical_section_enter();
+    TaskHandle_t waiter = group->waiter;
+    group->waiter = NULL;
+    cf_critical_section_exit();
+
+    if (waiter != NULL) {
+        xTaskNotifyGive(waiter);
+    }
+}
+
+/**
+ * @brief Drop references; frees the group when none are left
+ */
+static void group_unref(struct cf_task_group_s* group, uint32_t count)
+{
+    cf_critical_section_enter();
+    group->refs -= count;
+    bool release = (group->refs == 0 && !group->is_static);
+    cf_critical_section_exit();
+
+    if (release) {
+        cf_free(group->jobs);
+        cf_free(group);
+    }
+}
+
+/**
+ * @brief Pool task running one group job
+ *
+ * Finds nothing to do when the waiter already ran the job itself.
+ */
+static void group_runner(void* arg)
+{
+    struct cf_task_group_s* group = (struct cf_task_group_s*)arg;
+    cf_task_group_job_t job;
+
+    if (group_pop(group, &job)) {
+        job.function(job.arg);
+        group_finish(group);
+    }
+
+    group_unref(group, 1);
+}
+
+/**
+ * @brief Discard hook of a runner the pool dropped
+ *
+ * Its job stays in the group, where cf_task_group_wait() picks it up.
+ */
+static void group_discard(void* arg)
+{
+    group_unref((struct cf_task_group_s*)arg, 1);
+}
+
+//==============================================================================
+// PUBLIC API IMPLEMENTATION
+//==============================================================================
+
+cf_status_t cf_task_group_create(cf_task_group_t* group,
+                                 cf_threadpool_t pool,
+                                 uint32_t capacity,
+                                 cf_threadpool_priority_t priority)
+{
+    CF_PTR_CHECK(group);
+    *group = NULL;
+
+    if (capacity == 0) {
+        return CF_ERROR_INVALID_PARAM;
+    }
+
+    if (pool == NULL) {
+        pool = cf_threadpool_get_default();
+        if (pool == NULL) {
+            return CF_ERROR_NOT_INITIALIZED;
+        }
+    }
+
+    struct cf_task_group_s* g = (struct cf_task_group_s*)cf_alloc(sizeof(struct cf_task_group_s));
+    if (g == NULL) {
+        return CF_ERROR_NO_MEMORY;
+    }
+
+    memset(g, 0, sizeof(struct cf_task_group_s));
+
+    g->jobs = (cf_task_group_job_t*)cf_alloc(capacity * sizeof(cf_task_group_job_t));
+    if (g->jobs == NULL) {
+        cf_free(g);
+        return CF_ERROR_NO_MEMORY;
+    }
+
+    g->pool = pool;
+    g->priority = priority;
+    g->capacity = capacity;
+    g->refs = 1;
+
+    *group = g;
+    return CF_OK;
+}
+
+cf_status_t cf_task_group_create_static(cf_task_group_t* group,
+                                        cf_threadpool_t pool,
+                                        uint32_t capacity,
+                                        cf_threadpool_priority_t priority,
+                                        cf_task_group_job_t* jobs,
+                                        cf_task_group_static_t* storage)
+{
+    CF_PTR_CHECK(group);
+    *group = NULL;
+
+    CF_PTR_CHECK(jobs);
+    CF_PTR_CHECK(storage);
+
+    if (capacity == 0) {
+        return CF_ERROR_INVALID_PARAM;
+    }
+
+    if (pool == NULL) {
+        pool = cf_threadpool_get_default();
+        if (pool == NULL) {
+            return CF_ERROR_NOT_INITIALIZED;
+        }
+    }
+
+    struct cf_task_group_s* g = &storage->group;
+
+    memset(g, 0, sizeof(struct cf_task_group_s));
+
+    g->pool = pool;
+    g->priority = priority;
+    g->is_static = true;
+    g->jobs = jobs;
+    g->capacity = capacity;
+    g->refs = 1;
+
+    *group = g;
+    return CF_OK;
+}
+
+cf_status_t cf_task_group_destroy(cf_task_group_t group)
+{
+    if (group == NULL) {
+        return CF_OK;
+    }
+
+    if (cf_atomic_load(&group->pending) != 0) {
+        return CF_ERROR_BUSY;
+    }
+
+    if (group->is_static) {
+        // The caller takes the storage back on return: no runner may be left
+        cf_critical_section_enter();
+        bool busy = (group->refs > 1);
+        if (!busy) {
+            group->refs = 0;
+        }
+        cf_critical_section_exit();
+
+        return busy ? CF_ERROR_BUSY : CF_OK;
+    }
+
+    // Runners left over from jobs the waiter ran itself find nothing to do
+    // and drop their references as they return
+    group_unref(group, 1);
+
+    return CF_OK;
+}
+
+cf_status_t cf_task_group_submit(cf_task_group_t group,
+                                 cf_threadpool_task_func_t function,
+                                 void* arg)
+{
+    CF_PTR_CHECK(group);
+    CF_PTR_CHECK(function);
+
+    cf_critical_section_enter();
+    if (group->count >= group->capacity) {
+        cf_critical_section_exit();
+        return CF_ERROR_QUEUE_FULL;
+    }
+
+    cf_task_group_job_t* job = &group->jobs[(group->head + group->count) % group->capacity];
+    job->function = function;
+    job->arg = arg;
+    group->count++;
+    group->refs++;
+    cf_atomic_fetch_add(&group->pending, 1);
+
+    // A waiting owner may run the job itself if the workers are busy
+    TaskHandle_t waiter = group->waiter;
+    cf_critical_section_exit();
+
+    cf_threadpool_job_t runner = {
+        .function = group_runner,
+        .arg = group,
+        .priority = group->priority,
+        .discard = group_discard,
+        .no_caller_runs = true
+    };
+
+    if (cf_threadpool_submit_job(group->pool, &runner, 0) != CF_OK) {
+        // Pool full: the job waits in the group for the next runner or wait()
+        group_unref(group, 1);
+    }
+
+    if (waiter != NULL) {
+        xTaskNotifyGive(waiter);
+    }
+
+    return CF_OK;
+}
+
+cf_status_t cf_task_group_wait(cf_task_group_t group, uint32_t timeout_ms)
+{
+    CF_PTR_CHECK(group);
+
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    TickType_t start = (TickType_t)cf_time_get_tick_count();
+    TickType_t timeout = (timeout_ms == CF_WAIT_FOREVER) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+
+    for (;;) {
+        cf_task_group_job_t job;
+
+        // Help: run jobs no worker has picked up yet
+        while (group_pop(group, &job)) {
+            job.function(job.arg);
+            group_finish(group);
+        }
+
+        cf_critical_section_enter();
+        if (cf_atomic_load(&group->pending) == 0) {
+            group->waiter = NULL;
+            cf_critical_section_exit();
+            return CF_OK;
+        }
+        group->waiter = self;
+        cf_critical_section_exit();
+
+        TickType_t ticks = portMAX_DELAY;
+        if (timeout != portMAX_DELAY) {
+            TickType_t elapsed = (TickType_t)cf_time_get_tick_count() - start;
+            ticks = (elapsed < timeout) ? timeout - elapsed : 0;
+        }
+
+        if (ulTaskNotifyTake(pdTRUE, ticks) == 0 && ticks != portMAX_DELAY &&
+            (TickType_t)((TickType_t)cf_time_get_tick_count() - start) >= timeout) {
+            cf_critical_section_enter();
+            group->waiter = NULL;
+            bool done = (cf_atomic_load(&group->pending) == 0);
+            cf_critical_section_exit();
+
+            return done ? CF_OK : CF_ERROR_TIMEOUT;
+        }
+    }
+}
+
+uint32_t cf_task_group_pending(cf_task_group_t group)
+{
+    if (group == NULL) {
+        return 0;
+    }
+
+    return cf_atomic_load(&group->pending);
+}
+
+#endif /* CF_THREADPOOL_ENABLED && CF_RTOS_ENABLED */
@@ -0,0 +1,213 @@
+/**
+ * @file cf_threadpool_group.h
+ * @brief ThreadPool task groups (structured fork/join)
+ * @version 1.0.0
+ * @date 2025-11-20
+ * @author CFramework Contributors
+ *
+ * @copyright Copyright (c) 2025 CFramework
+ * Licensed under MIT License
+ *
+ * @description
+ * A task group collects jobs so that their submitter can wait for exactly
+ * those jobs, unlike cf_threadpool_wait_idle() which also waits for
+ * unrelated work. Jobs are kept in the group and each submission queues
+ * one pool task that runs the oldest waiting job. cf_task_group_wait()
+ * runs jobs that no worker has picked up yet on the calling task, then
+ * sleeps on a task notification until the last running job finishes. A job
+ * may therefore wait on a group from inside the pool without deadlocking,
+ * and the waiting task keeps a core busy instead of idling.
+ *
+ * A group can be reused: once cf_task_group_wait() has returned CF_OK it
+ * takes new jobs. With CF_STATIC_ALLOCATION, cf_free() returns nothing to
+ * the arena, so groups created per operation exhaust it; create them once
+ * with cf_task_group_create_static() and reuse them instead.
+ */
+
+#ifndef CF_THREADPOOL_GROUP_H
+#define CF_THREADPOOL_GROUP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cf_common.h"
+
+#include "os/cf_atomic.h"
+#include "os/cf_task.h"
+#include "threadpool/cf_threadpool.h"
+
+#if CF_THREADPOOL_ENABLED && CF_RTOS_ENABLED
+
+//==============================================================================
+// TYPE DEFINITIONS
+//==============================================================================
+
+/**
+ * @brief Opaque task group handle
+ */
+typedef struct cf_task_group_s* cf_task_group_t;
+
+/**
+ * @brief Group job slot
+ *
+ * Defined here only so that job storage for cf_task_group_create_static()
+ * can be sized; the fields are private.
+ */
+typedef struct {
+    cf_threadpool_task_func_t function;
+    void* arg;
+} cf_task_group_job_t;
+
+/**
+ * @brief Task group object
+ *
+ * Defined here only so that cf_task_group_static_t can be sized; the
+ * fields are private. Referenced by its owner and by every pool task
+ * queued for it; the last reference frees it. All fields below is_static,
+ * except pending, are guarded by the critical section.
+ */
+struct cf_task_group_s {
+    cf_threadpool_t pool;
+    cf_threadpool_priority_t priority;
+    bool is_static;                 /**< Storage owned by the caller */
+
+    cf_task_group_job_t* jobs;
+    uint32_t capacity;
+    uint32_t head;                  /**< Index of oldest waiting job */
+    uint32_t count;                 /**< Jobs not yet started */
+
+    uint32_t refs;                  /**< Owner + queued or running pool tasks */
+    TaskHandle_t waiter;            /**< Task blocked in cf_task_group_wait() */
+
+    cf_atomic_u32_t pending;        /**< Jobs submitted and not finished */
+};
+
+/**
+ * @brief Caller-provided storage for cf_task_group_create_static()
+ */
+typedef struct {
+    struct cf_task_group_s group;
+} cf_task_group_static_t;
+
+//==============================================================================
+// PUBLIC API
+//==============================================================================
+
+/**
+ * @brief Create a task group
+ *
+ * @param[out] group Pointer to receive group handle
+ * @param[in] pool Pool the jobs run on (NULL = default instance)
+ * @param[in] capacity Maximum number of jobs waiting in the group
+ * @param[in] priority Priority of the group's jobs
+ *
+ * @return CF_OK on success
+ * @return CF_ERROR_NULL_POINTER if group is NULL
+ * @return CF_ERROR_INVALID_PARAM if capacity is 0
+ * @return CF_ERROR_NOT_INITIALIZED if the pool is not initialized
+ * @return CF_ERROR_NO_MEMORY if allocation failed
+ */
+cf_status_t cf_task_group_create(cf_task_group_t* group,
+                                 cf_threadpool_t pool,
+                                 uint32_t capacity,
+                                 cf_threadpool_priority_t priority);
+
+/**
+ * @brief Create a task group in caller-provided storage
+ *
+ * No heap memory is used. Both buffers must stay valid until
+ * cf_task_group_destroy() returns CF_OK, which does not free them.
+ *
+ * @param[out] group Pointer to receive group handle
+ * @param[in] pool Pool the jobs run on (NULL = default instance)
+ * @param[in] capacity Maximum number of jobs waiting in the group
+ * @param[in] priority Priority of the group's jobs
+ * @param[in] jobs Job storage of capacity entries
+ * @param[in] storage Storage for the group
+ *
+ * @return CF_OK on success
+ * @return CF_ERROR_NULL_POINTER if group, jobs or storage is NULL
+ * @return CF_ERROR_INVALID_PARAM if capacity is 0
+ * @return CF_ERROR_NOT_INITIALIZED if the pool is not initialized
+ */
+cf_status_t cf_task_group_create_static(cf_task_group_t* group,
+                                        cf_threadpool_t pool,
+                                        uint32_t capacity,
+                                        cf_threadpool_priority_t priority,
+                                        cf_task_group_job_t* jobs,
+                                        cf_task_group_static_t* storage);
+
+/**
+ * @brief Destroy a task group
+ *
+ * Pool tasks still queued for the group find nothing to do when they run.
+ * The memory is released once the last of them has returned. A group in
+ * caller-provided storage cannot outlive the call, so it stays busy until
+ * those pool tasks have run.
+ *
+ * @param[in] group Group handle (NULL is ignored)
+ *
+ * @return CF_OK on success (also for NULL)
+ * @return CF_ERROR_BUSY if jobs are still waiting or running, or pool tasks
+ *         still refer to a group in caller-provided storage
+ */
+cf_status_t cf_task_group_destroy(cf_task_group_t group);
+
+/**
+ * @brief Submit a job to a group
+ *
+ * Never blocks. If the pool queue is full the job stays in the group and
+ * is run by a worker that frees up or by cf_task_group_wait().
+ *
+ * @param[in] group Group handle
+ * @param[in] function Job function to execute
+ * @param[in] arg Argument to pass to function
+ *
+ * @return CF_OK on success
+ * @return CF_ERROR_NULL_POINTER if group or function is NULL
+ * @return CF_ERROR_QUEUE_FULL if the group holds capacity waiting jobs
+ *
+ * @note This function is thread-safe; jobs may submit to their own group
+ */
+cf_status_t cf_task_group_submit(cf_task_group_t group,
+                                 cf_threadpool_task_func_t function,
+                                 void* arg);
+
+/**
+ * @brief Wait until every job submitted to a group has finished
+ *
+ * Jobs not yet started are run on the calling task. Jobs submitted while
+ * waiting are waited for as well. The timeout only bounds the blocking
+ * part; a job run on the calling task always runs to completion.
+ *
+ * @param[in] group Group handle
+ * @param[in] timeout_ms Timeout in milliseconds (CF_WAIT_FOREVER = no timeout)
+ *
+ * @return CF_OK when no job is waiting or running
+ * @return CF_ERROR_NULL_POINTER if group is NULL
+ * @return CF_ERROR_TIMEOUT if jobs were still running at the timeout
+ *
+ * @note Only one task may wait on a group at a time
+ * @note May be called from a pool job
+ */
+cf_status_t cf_task_group_wait(cf_task_group_t group, uint32_t timeout_ms);
+
+/**
+ * @brief Get the number of jobs waiting or running in a group
+ *
+ * @param[in] group Group handle
+ *
+ * @return Unfinished jobs (0 if group is NULL)
+ *
+ * @note This function is thread-safe
+ */
+uint32_t cf_task_group_pending(cf_task_group_t group);
+
+#endif /* CF_THREADPOOL_ENABLED && CF_RTOS_ENABLED */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CF_THREADPOOL_GROUP_H */
@@ -0,0 +1,247 @@
+/**
+ * @file cf_threadpool_parallel.c
+ * @brief ThreadPool parallel-for implementation
+ */
+
+#include "threadpool/cf_threadpool_parallel.h"
+
+#if CF_THREADPOOL_ENABLED && CF_RTOS_ENABLED
+
+#include "cf_assert.h"
+#include "os/cf_atomic.h"
+#include "os/cf_critical.h"
+
+// Include FreeRTOS task API for the completion notification
+#ifdef ESP_PLATFORM
+    #include "freertos/FreeRTOS.h"
+    #include "freertos/task.h"
+#else
+    #include "FreeRTOS.h"
+    #include "task.h"
+#endif
+
+#include <string.h>
+
+//==============================================================================
+// PRIVATE TYPES
+//==============================================================================
+
+/**
+ * @brief Shared state of one parallel_for call
+ *
+ * Referenced by the caller and by every queued helper. A helper that starts
+ * after all chunks are gone just drops its reference, so the caller never
+ * waits for helpers that did not get to run.
+ */
+typedef struct {
+    uint8_t refs;                   /**< 0 = free slot */
+    TaskHandle_t waiter;            /**< Caller, while blocked on the last chunk */
+
+    cf_threadpool_range_func_t function;
+    void* ctx;
+    size_t begin;
+    size_t end;
+    size_t grain;
+    uint32_t chunks;
+
+    cf_atomic_u32_t next;           /**< Next chunk to hand out */
+    cf_atomic_u32_t done;           /**< Chunks finished */
+} cf_threadpool_parallel_t;
+
+//==============================================================================
+// PRIVATE VARIABLES
+//==============================================================================
+
+static cf_threadpool_parallel_t g_parallel[CF_THREADPOOL_PARALLEL_SLOTS];
+
+//==============================================================================
+// PRIVATE FUNCTIONS
+//==============================================================================
+
+/**
+ * @brief Allocate a slot (caller reference taken)
+ */
+static cf_threadpool_parallel_t* parallel_alloc(void)
+{
+    cf_threadpool_parallel_t* job = NULL;
+
+    cf_critical_section_enter();
+    for (uint32_t i = 0; i < CF_THREADPOOL_PARALLEL_SLOTS; i++) {
+        if (g_parallel[i].refs == 0) {
+            job = &g_parallel[i];
+            memset(job, 0, sizeof(*job));
+            job->refs = 1;
+            break;
+        }
+    }
+    cf_critical_section_exit();
+
+    return job;
+}
+
+/**
+ * @brief Drop one reference (slot returns to the pool at zero)
+ */
+static void parallel_unref(cf_threadpool_parallel_t* job)
+{
+    cf_critical_section_enter();
+    job->refs--;
+    cf_critical_section_exit();
+}
+
+/**
+ * @brief Claim and run chunks until none are left
+ */
+static void run_chunks(cf_threadpool_parallel_t* job)
+{
+    for (;;) {
+        uint32_t chunk = cf_atomic_fetch_add(&job->next, 1);
+        if (chunk >= job->chunks) {
+            return;
+        }
+
+        size_t lo = job->begin + (size_t)chunk * job->grain;
+        size_t hi = (job->end - lo > job->grain) ? lo + job->grain : job->end;
+
+        job->function(lo, hi, job->ctx);
+
+        if (cf_atomic_fetch_add(&job->done, 1) + 1 == job->chunks) {
+            // Last chunk: wake the caller if it is already waiting
+            cf_critical_section_enter();
+            TaskHandle_t waiter = job->waiter;
+            job->waiter = NULL;
+            cf_critical_section_exit();
+
+            if (waiter != NULL) {
+                xTaskNotifyGive(waiter);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Pool task helping with a parallel_for call
+ */
+static void parallel_helper(void* arg)
+{
+    cf_threadpool_parallel_t* job = (cf_threadpool_parallel_t*)arg;
+
+    run_chunks(job);
+    parallel_unref(job);
+}
+
+/**
+ * @brief Discard hook of a helper the pool dropped: only its reference is left
+ */
+static void parallel_discard(void* arg)
+{
+    parallel_unref((cf_threadpool_parallel_t*)arg);
+}
+
+//==============================================================================
+// PUBLIC API IMPLEMENTATION
+//==============================================================================
+
+cf_status_t cf_threadpool_parallel_for(size_t begin,
+                                        size_t end,
+                                        size_t grain,
+                                        cf_threadpool_range_func_t function,
+                                        void* ctx)
+{
+    return cf_threadpool_parallel_for_on(NULL, begin, end, grain, function, ctx);
+}
+
+cf_status_t cf_threadpool_parallel_for_on(cf_threadpool_t pool,
+                                           size_t begin,
+                                           size_t end,
+                                           size_t grain,
+                                           cf_threadpool_range_func_t function,
+                                           void* ctx)
+{
+    CF_PTR_CHECK(function);
+
+    if (begin > end) {
+        return CF_ERROR_INVALID_PARAM;
+    }
+
+    cf_threadpool_stats_t stats;
+    cf_status_t status = cf_threadpool_get_stats(pool, &stats);
+    if (status != CF_OK) {
+        return status;
+    }
+
+    if (begin == end) {
+        return CF_OK;
+    }
+
+    size_t count = end - begin;
+    size_t threads = (size_t)stats.thread_count + 1;
+
+    if (grain == 0) {
+        grain = (count + threads * 4 - 1) / (threads * 4);
+    }
+    if (count / grain >= UINT32_MAX) {
+        grain = count / (UINT32_MAX - 1) + 1;
+    }
+
+    uint32_t chunks = (uint32_t)((count + grain - 1) / grain);
+    cf_threadpool_parallel_t* job = (chunks > 1) ? parallel_alloc() : NULL;
+
+    // Serial fallback: single chunk or all slots busy
+    if (job == NULL) {
+        function(begin, end, ctx);
+        return CF_OK;
+    }
+
+    job->function = function;
+    job->ctx = ctx;
+    job->begin = begin;
+    job->end = end;
+    job->grain = grain;
+    job->chunks = chunks;
+
+    // One helper per worker at most; the caller takes the remaining share.
+    // A helper the pool cannot queue is not run inline: the caller's own
+    // share covers it.
+    cf_threadpool_job_t helper = {
+        .function = parallel_helper,
+        .arg = job,
+        .priority = CF_THREADPOOL_PRIORITY_NORMAL,
+        .discard = parallel_discard,
+        .no_caller_runs = true
+    };
+    uint32_t helpers = CF_MIN(stats.thread_count, chunks - 1);
+    for (uint32_t i = 0; i < helpers; i++) {
+        cf_critical_section_enter();
+        job->refs++;
+        cf_critical_section_exit();
+
+        if (cf_threadpool_submit_job(pool, &helper, 0) != CF_OK) {
+            parallel_unref(job);
+            break;
+        }
+    }
+
+    run_chunks(job);
+
+    // Wait for chunks still running on helpers
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    for (;;) {
+        cf_critical_section_enter();
+        if (cf_atomic_load(&job->done) == chunks) {
+            job->waiter = NULL;
+            cf_critical_section_exit();
+            break;
+        }
+        job->waiter = self;
+        cf_critical_section_exit();
+
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+
+    parallel_unref(job);
+
+    return CF_OK;
+}
+
+#endif /* CF_THREADPOOL_ENABLED && CF_RTOS_ENABLED */
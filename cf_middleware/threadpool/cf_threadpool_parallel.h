@@ -0,0 +1,101 @@
+/**
+ * @file cf_threadpool_parallel.h
+ * @brief ThreadPool parallel-for (range splitting)
+ * @version 1.0.0
+ * @date 2025-11-20
+ * @author CFramework Contributors
+ *
+ * @copyright Copyright (c) 2025 CFramework
+ * Licensed under MIT License
+ */
+
+#ifndef CF_THREADPOOL_PARALLEL_H
+#define CF_THREADPOOL_PARALLEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cf_common.h"
+
+#include "threadpool/cf_threadpool.h"
+
+#if CF_THREADPOOL_ENABLED && CF_RTOS_ENABLED
+
+//==============================================================================
+// TYPE DEFINITIONS
+//==============================================================================
+
+/**
+ * @brief Range body function type
+ *
+ * Called once per chunk with the half-open index range [begin, end).
+ * Chunks of one call may run concurrently on different workers.
+ *
+ * @param[in] begin First index of the chunk
+ * @param[in] end One past the last index of the chunk
+ * @param[in] ctx User context passed to cf_threadpool_parallel_for()
+ */
+typedef void (*cf_threadpool_range_func_t)(size_t begin, size_t end, void* ctx);
+
+//==============================================================================
+// PUBLIC API
+//==============================================================================
+
+/**
+ * @brief Run a function over an index range on the default ThreadPool
+ *
+ * The range [begin, end) is split into chunks of grain indices. Helper
+ * tasks are queued on the pool (at most one per worker) and the calling
+ * task works on chunks as well; chunks are handed out one at a time, so a
+ * slow chunk does not hold up the others. Returns once every chunk has
+ * run.
+ *
+ * Bookkeeping lives in one of CF_THREADPOOL_PARALLEL_SLOTS static slots;
+ * no heap memory is used. If no slot is free or no helper can be queued,
+ * the caller simply runs the chunks itself.
+ *
+ * @param[in] begin First index
+ * @param[in] end One past the last index
+ * @param[in] grain Indices per chunk (0 = about four chunks per thread)
+ * @param[in] function Range body
+ * @param[in] ctx User context passed to function
+ *
+ * @return CF_OK when all chunks have run
+ * @return CF_ERROR_NULL_POINTER if function is NULL
+ * @return CF_ERROR_INVALID_PARAM if begin > end
+ * @return CF_ERROR_NOT_INITIALIZED if the pool is not initialized
+ *
+ * @note This function is thread-safe; it may be called from a pool task
+ *       (nested calls cannot deadlock, the caller runs what no helper took)
+ * @note Helpers run at CF_THREADPOOL_PRIORITY_NORMAL
+ * @warning Uses the calling task's notification value to wait for the
+ *          last running chunk (see cf_threadpool_future_wait())
+ */
+cf_status_t cf_threadpool_parallel_for(size_t begin,
+                                        size_t end,
+                                        size_t grain,
+                                        cf_threadpool_range_func_t function,
+                                        void* ctx);
+
+/**
+ * @brief Run a function over an index range on a specific ThreadPool
+ *
+ * @param[in] pool Pool handle (NULL = default instance)
+ *
+ * @return See cf_threadpool_parallel_for()
+ */
+cf_status_t cf_threadpool_parallel_for_on(cf_threadpool_t pool,
+                                           size_t begin,
+                                           size_t end,
+                                           size_t grain,
+                                           cf_threadpool_range_func_t function,
+                                           void* ctx);
+
+#endif /* CF_THREADPOOL_ENABLED && CF_RTOS_ENABLED */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CF_THREADPOOL_PARALLEL_H */
@@ -0,0 +1,334 @@
+/**
+ * @file cf_threadpool_strand.c
+ * @brief ThreadPool strand implementation
+ */
+
+#include "threadpool/cf_threadpool_strand.h"
+
+#if CF_THREADPOOL_ENABLED && CF_RTOS_ENABLED
+
+#include "cf_assert.h"
+#include "os/cf_alloc.h"
+#include "os/cf_critical.h"
+
+#ifdef ESP_PLATFORM
+    #include "freertos/FreeRTOS.h"
+#else
+    #include "FreeRTOS.h"
+#endif
+
+#include <string.h>
+
+//==============================================================================
+// PRIVATE TYPES
+//==============================================================================
+
+/**
+ * @brief Strand job
+ */
+typedef struct {
+    cf_threadpool_task_func_t function;
+    void* arg;
+} cf_threadpool_strand_job_t;
+
+/**
+ * @brief Strand structure
+ *
+ * All fields below priority are guarded by the critical section.
+ */
+struct cf_threadpool_strand_s {
+    cf_threadpool_t pool;
+    cf_threadpool_priority_t priority;
+
+    cf_threadpool_strand_job_t* jobs;
+    uint32_t capacity;
+    uint32_t head;              /**< Index of oldest job */
+    uint32_t count;
+
+    bool scheduled;             /**< A pool task owns the strand (queued or draining) */
+    bool starting;              /**< A poster is queueing the first pool task */
+};
+
+//==============================================================================
+// PRIVATE FUNCTIONS
+//==============================================================================
+
+/**
+ * @brief Append a job (critical section held)
+ */
+static bool strand_push(struct cf_threadpool_strand_s* strand,
+                        cf_threadpool_task_func_t function,
+                        void* arg)
+{
+    if (strand->count >= strand->capacity) {
+        return false;
+    }
+
+    cf_threadpool_strand_job_t* job = &strand->jobs[(strand->head + strand->count) % strand->capacity];
+    job->function = function;
+    job->arg = arg;
+    strand->count++;
+
+    return true;
+}
+
+/**
+ * @brief Claim an idle strand's start and append a job (critical section held)
+ *
+ * While one poster is starting the strand every other post fails, so that
+ * if the start fails the job just pushed is the only one to take back and
+ * no accepted job is left without a drainer.
+ *
+ * @param[out] start Set to true if the caller must queue the drainer
+ */
+static cf_status_t strand_enqueue(struct cf_threadpool_strand_s* strand,
+                                  cf_threadpool_task_func_t function,
+                                  void* arg,
+                                  bool* start)
+{
+    if (strand->starting) {
+        return CF_ERROR_BUSY;
+    }
+
+    if (!strand_push(strand, function, arg)) {
+        return CF_ERROR_QUEUE_FULL;
+    }
+
+    *start = !strand->scheduled;
+    if (*start) {
+        strand->scheduled = true;
+        strand->starting = true;
+    }
+
+    return CF_OK;
+}
+
+/**
+ * @brief End a start claimed by strand_enqueue() (critical section held)
+ *
+ * On failure the starter's job is still the newest and, as nothing can
+ * have been posted or drained meanwhile, the only one.
+ */
+static void strand_started(struct cf_threadpool_strand_s* strand, cf_status_t status)
+{
+    strand->starting = false;
+
+    if (status != CF_OK) {
+        strand->count--;
+        strand->scheduled = false;
+    }
+}
+
+/**
+ * @brief Discard hook of the drainer: the pool dropped it with its strand
+ *
+ * Only happens when the pool is destroyed without waiting, so the strand's
+ * jobs are dropped as well and the strand becomes idle.
+ */
+static void strand_discard(void* arg)
+{
+    struct cf_threadpool_strand_s* strand = (struct cf_threadpool_strand_s*)arg;
+
+    cf_critical_section_enter();
+    strand->count = 0;
+    strand->scheduled = false;
+    cf_critical_section_exit();
+}
+
+static void strand_run(void* arg);
+
+/**
+ * @brief Queue the drainer of a strand
+ *
+ * Never runs it on the calling task: a poster must not end up draining
+ * other posters' jobs, and a requeueing drainer must not recurse.
+ */
+static cf_status_t strand_schedule(struct cf_threadpool_strand_s* strand)
+{
+    cf_threadpool_job_t job = {
+        .function = strand_run,
+        .arg = strand,
+        .priority = strand->priority,
+        .discard = strand_discard,
+        .no_caller_runs = true
+    };
+
+    return cf_threadpool_submit_job(strand->pool, &job, 0);
+}
+
+/**
+ * @brief Pool task draining a strand
+ *
+ * Runs up to CF_THREADPOOL_STRAND_BATCH jobs, then requeues itself so a
+ * busy strand does not hold a worker forever. The strand stays scheduled
+ * until it is found empty, which is what keeps a second drainer out.
+ */
+static void strand_run(void* arg)
+{
+    struct cf_threadpool_strand_s* strand = (struct cf_threadpool_strand_s*)arg;
+    uint32_t done = 0;
+
+    for (;;) {
+        cf_threadpool_strand_job_t job;
+
+        cf_critical_section_enter();
+        if (strand->count == 0) {
+            // After this the strand may be destroyed by its owner
+            strand->scheduled = false;
+            cf_critical_section_exit();
+            return;
+        }
+        cf_critical_section_exit();
+
+        if (done >= CF_THREADPOOL_STRAND_BATCH) {
+            if (strand_schedule(strand) == CF_OK) {
+                return;
+            }
+            // Pool full: keep draining here
+            done = 0;
+        }
+
+        cf_critical_section_enter();
+        job = strand->jobs[strand->head];
+        strand->head = (strand->head + 1) % strand->capacity;
+        strand->count--;
+        cf_critical_section_exit();
+
+        job.function(job.arg);
+        done++;
+    }
+}
+
+//==============================================================================
+// PUBLIC API IMPLEMENTATION
+//==============================================================================
+
+cf_status_t cf_threadpool_strand_create(cf_threadpool_strand_t* strand,
+                                         cf_threadpool_t pool,
+                                         uint32_t capacity,
+                                         cf_threadpool_priority_t priority)
+{
+    CF_PTR_CHECK(strand);
+    *strand = NULL;
+
+    if (capacity == 0) {
+        return CF_ERROR_INVALID_PARAM;
+    }
+
+    struct cf_threadpool_strand_s* s = (struct cf_threadpool_strand_s*)cf_alloc(sizeof(struct cf_threadpool_strand_s));
+    if (s == NULL) {
+        return CF_ERROR_NO_MEMORY;
+    }
+
+    memset(s, 0, sizeof(struct cf_threadpool_strand_s));
+
+    s->jobs = (cf_threadpool_strand_job_t*)cf_alloc(capacity * sizeof(cf_threadpool_strand_job_t));
+    if (s->jobs == NULL) {
+        cf_free(s);
+        return CF_ERROR_NO_MEMORY;
+    }
+
+    s->pool = pool;
+    s->priority = priority;
+    s->capacity = capacity;
+
+    *strand = s;
+    return CF_OK;
+}
+
+cf_status_t cf_threadpool_strand_destroy(cf_threadpool_strand_t strand)
+{
+    if (strand == NULL) {
+        return CF_OK;
+    }
+
+    if (!cf_threadpool_strand_is_idle(strand)) {
+        return CF_ERROR_BUSY;
+    }
+
+    cf_free(strand->jobs);
+    cf_free(strand);
+
+    return CF_OK;
+}
+
+cf_status_t cf_threadpool_strand_post(cf_threadpool_strand_t strand,
+                                       cf_threadpool_task_func_t function,
+                                       void* arg)
+{
+    CF_PTR_CHECK(strand);
+    CF_PTR_CHECK(function);
+
+    bool start = false;
+
+    cf_critical_section_enter();
+    cf_status_t status = strand_enqueue(strand, function, arg, &start);
+    cf_critical_section_exit();
+
+    if (status != CF_OK || !start) {
+        return status;
+    }
+
+    status = strand_schedule(strand);
+
+    cf_critical_section_enter();
+    strand_started(strand, status);
+    cf_critical_section_exit();
+
+    return status;
+}
+
+cf_status_t cf_threadpool_strand_post_from_isr(cf_threadpool_strand_t strand,
+                                                cf_threadpool_task_func_t function,
+                                                void* arg,
+                                                BaseType_t* pxHigherPriorityTaskWoken)
+{
+    CF_PTR_CHECK(strand);
+    CF_PTR_CHECK(function);
+
+    bool start = false;
+
+    cf_critical_state_t state = cf_critical_section_enter_from_isr();
+    cf_status_t status = strand_enqueue(strand, function, arg, &start);
+    cf_critical_section_exit_from_isr(state);
+
+    if (status != CF_OK || !start) {
+        return status;
+    }
+
+    cf_threadpool_job_t job = {
+        .function = strand_run,
+        .arg = strand,
+        .priority = strand->priority,
+        .discard = strand_discard
+    };
+
+    status = cf_threadpool_submit_batch_to_from_isr(strand->pool, &job, 1, NULL,
+                                                    pxHigherPriorityTaskWoken);
+
+    state = cf_critical_section_enter_from_isr();
+    strand_started(strand, status);
+    cf_critical_section_exit_from_isr(state);
+
+    return status;
+}
+
+uint32_t cf_threadpool_strand_pending(cf_threadpool_strand_t strand)
+{
+    if (strand == NULL) {
+        return 0;
+    }
+
+    return strand->count;
+}
+
+bool cf_threadpool_strand_is_idle(cf_threadpool_strand_t strand)
+{
+    if (strand == NULL) {
+        return true;
+    }
+
+    return !strand->scheduled && strand->count == 0;
+}
+
+#endif /* CF_THREADPOOL_ENABLED && CF_RTOS_ENABLED */
@@ -0,0 +1,152 @@
+/**
+ * @file cf_threadpool_strand.h
+ * @brief ThreadPool strands (serial executors)
+ * @version 1.0.0
+ * @date 2025-11-20
+ * @author CFramework Contributors
+ *
+ * @copyright Copyright (c) 2025 CFramework
+ * Licensed under MIT License
+ *
+ * @description
+ * A strand is a FIFO of jobs bound to a pool. Jobs posted to one strand
+ * run one at a time, in posting order; different strands run in parallel.
+ * Instead of a mutex, serialization comes from having at most one pool
+ * task draining a strand at any time, so no worker ever blocks waiting
+ * for another one (e.g. one strand per UART or per sensor).
+ */
+
+#ifndef CF_THREADPOOL_STRAND_H
+#define CF_THREADPOOL_STRAND_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cf_common.h"
+
+#include "threadpool/cf_threadpool.h"
+
+#if CF_THREADPOOL_ENABLED && CF_RTOS_ENABLED
+
+//==============================================================================
+// TYPE DEFINITIONS
+//==============================================================================
+
+/**
+ * @brief Opaque strand handle
+ */
+typedef struct cf_threadpool_strand_s* cf_threadpool_strand_t;
+
+//==============================================================================
+// PUBLIC API
+//==============================================================================
+
+/**
+ * @brief Create a strand
+ *
+ * @param[out] strand Pointer to receive strand handle
+ * @param[in] pool Pool the jobs run on (NULL = default instance)
+ * @param[in] capacity Maximum number of jobs waiting in the strand
+ * @param[in] priority Priority of the pool task draining the strand
+ *
+ * @return CF_OK on success
+ * @return CF_ERROR_NULL_POINTER if strand is NULL
+ * @return CF_ERROR_INVALID_PARAM if capacity is 0
+ * @return CF_ERROR_NO_MEMORY if allocation failed
+ */
+cf_status_t cf_threadpool_strand_create(cf_threadpool_strand_t* strand,
+                                         cf_threadpool_t pool,
+                                         uint32_t capacity,
+                                         cf_threadpool_priority_t priority);
+
+/**
+ * @brief Destroy a strand
+ *
+ * @param[in] strand Strand handle (NULL is ignored)
+ *
+ * @return CF_OK on success (also for NULL)
+ * @return CF_ERROR_BUSY if jobs are still waiting or running
+ */
+cf_status_t cf_threadpool_strand_destroy(cf_threadpool_strand_t strand);
+
+/**
+ * @brief Post a job to a strand
+ *
+ * The job runs after every job posted to the strand before it, and never
+ * concurrently with another job of the same strand. Never blocks and never
+ * runs jobs on the calling task. If the strand is idle and the pool queue
+ * is full, the job is taken back and CF_ERROR_QUEUE_FULL returned. While a
+ * post is starting an idle strand, other posts fail with CF_ERROR_BUSY, so
+ * an accepted job always has a pool task to run it.
+ *
+ * @param[in] strand Strand handle
+ * @param[in] function Job function to execute
+ * @param[in] arg Argument to pass to function
+ *
+ * @return CF_OK on success
+ * @return CF_ERROR_NULL_POINTER if strand or function is NULL
+ * @return CF_ERROR_QUEUE_FULL if the strand holds capacity jobs already,
+ *         or the pool queue needed to start an idle strand is full
+ * @return CF_ERROR_BUSY if another post is starting the strand right now
+ * @return Other errors from cf_threadpool_submit_job()
+ *
+ * @note This function is thread-safe
+ * @note Jobs may post to their own strand; such a job runs after the
+ *       current one has returned
+ */
+cf_status_t cf_threadpool_strand_post(cf_threadpool_strand_t strand,
+                                       cf_threadpool_task_func_t function,
+                                       void* arg);
+
+/**
+ * @brief Post a job to a strand from ISR context
+ *
+ * @param[in] strand Strand handle
+ * @param[in] function Job function to execute
+ * @param[in] arg Argument to pass to function
+ * @param[out] pxHigherPriorityTaskWoken Set to pdTRUE if context switch needed
+ *
+ * @return CF_OK on success
+ * @return CF_ERROR_NULL_POINTER if strand or function is NULL
+ * @return CF_ERROR_QUEUE_FULL if the strand, or the pool queue needed to
+ *         start an idle strand, is full
+ * @return CF_ERROR_BUSY if another post is starting the strand right now
+ * @return Other errors from cf_threadpool_submit_batch_to_from_isr()
+ *
+ * @note This function is ISR-safe
+ */
+cf_status_t cf_threadpool_strand_post_from_isr(cf_threadpool_strand_t strand,
+                                                cf_threadpool_task_func_t function,
+                                                void* arg,
+                                                BaseType_t* pxHigherPriorityTaskWoken);
+
+/**
+ * @brief Get the number of jobs waiting in a strand
+ *
+ * @param[in] strand Strand handle
+ *
+ * @return Jobs posted but not yet started (0 if strand is NULL)
+ *
+ * @note This function is thread-safe and ISR-safe
+ */
+uint32_t cf_threadpool_strand_pending(cf_threadpool_strand_t strand);
+
+/**
+ * @brief Check whether a strand has no waiting or running jobs
+ *
+ * @param[in] strand Strand handle
+ *
+ * @return true if idle (or if strand is NULL), false otherwise
+ *
+ * @note This function is thread-safe and ISR-safe
+ */
+bool cf_threadpool_strand_is_idle(cf_threadpool_strand_t strand);
+
+#endif /* CF_THREADPOOL_ENABLED && CF_RTOS_ENABLED */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CF_THREADPOOL_STRAND_H */
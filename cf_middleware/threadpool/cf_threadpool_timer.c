@@ -0,0 +1,619 @@
+/**
+ * @file cf_threadpool_timer.c
+ * @brief ThreadPool delayed and periodic job submission implementation
+ */
+
+#include "threadpool/cf_threadpool_timer.h"
+
+#if CF_THREADPOOL_ENABLED && CF_RTOS_ENABLED
+
+#include "cf_assert.h"
+#include "os/cf_critical.h"
+#include "os/cf_semaphore.h"
+#include "os/cf_task.h"
+#include "os/cf_time.h"
+#include "os/cf_timer.h"
+
+#include <string.h>
+
+//==============================================================================
+// PRIVATE DEFINITIONS
+//==============================================================================
+
+#define WHEEL_BITS      6
+#define WHEEL_SIZE      (1UL << WHEEL_BITS)
+#define WHEEL_MASK      (WHEEL_SIZE - 1)
+#define WHEEL_LEVELS    4
+#define WHEEL_SPAN      (1UL << (WHEEL_BITS * WHEEL_LEVELS))    /**< Ticks covered */
+
+#define ENTRY_NIL       0xFFFFU
+
+//==============================================================================
+// PRIVATE TYPES
+//==============================================================================
+
+/**
+ * @brief Entry state
+ */
+typedef enum {
+    ENTRY_FREE = 0,
+    ENTRY_PENDING,              /**< Linked into a wheel slot */
+    ENTRY_FIRING                /**< Detached, being submitted by the driver */
+} entry_state_t;
+
+/**
+ * @brief Delayed job
+ */
+typedef struct {
+    cf_threadpool_t pool;
+    cf_threadpool_task_func_t function;
+    void* arg;
+    cf_threadpool_priority_t priority;
+
+    uint32_t expires;           /**< Wheel tick to fire at */
+    uint32_t period;            /**< Wheel ticks, 0 = one-shot */
+
+    uint16_t next;
+    uint16_t prev;
+    uint16_t generation;        /**< Bumped on free, part of the handle */
+    uint8_t level;
+    uint8_t slot;
+    uint8_t state;
+    bool cancelled;             /**< Cancelled while firing */
+} cf_threadpool_timer_entry_t;
+
+/**
+ * @brief Timer wheel
+ *
+ * Level L holds jobs due within WHEEL_SIZE^(L+1) ticks, in the slot given by
+ * bits [6L, 6L+6) of their expiry. Whenever level L wraps, the next slot of
+ * level L+1 is cascaded down. The driver only runs while jobs are linked.
+ * All fields are guarded by the critical section.
+ */
+typedef struct {
+    bool initialized;
+    bool initializing;
+    bool driving;               /**< Driver started (or a start is on its way) */
+    bool dispatching;           /**< Driver is submitting detached jobs */
+
+    cf_semaphore_t dispatch_sem;    /**< Signalled once per waiter when a dispatch ends */
+    uint32_t dispatch_waiters;
+    uint32_t dispatch_generation;   /**< Bumped every time a dispatch ends */
+
+    cf_timer_t driver;
+    TickType_t tick_period;     /**< OS ticks per wheel tick */
+    TickType_t last_os_tick;
+    uint32_t now;               /**< Current wheel tick */
+    uint32_t pending;           /**< Jobs linked into the wheel */
+
+    uint16_t free_head;
+    uint16_t heads[WHEEL_LEVELS][WHEEL_SIZE];
+    cf_threadpool_timer_entry_t entries[CF_THREADPOOL_TIMER_SLOTS];
+} cf_threadpool_timer_wheel_t;
+
+//==============================================================================
+// PRIVATE VARIABLES
+//==============================================================================
+
+static cf_threadpool_timer_wheel_t g_wheel;
+
+//==============================================================================
+// PRIVATE FUNCTIONS
+//==============================================================================
+
+/**
+ * @brief Link an entry into the slot matching its expiry (critical section held)
+ */
+static void wheel_insert(uint16_t index)
+{
+    cf_threadpool_timer_entry_t* e = &g_wheel.entries[index];
+    uint32_t delta = e->expires - g_wheel.now;
+    uint32_t when = e->expires;
+    uint32_t level = 0;
+
+    // Far-future jobs park in the top level and are re-placed on cascade
+    if (delta >= WHEEL_SPAN) {
+        when = g_wheel.now + WHEEL_SPAN - 1;
+        delta = WHEEL_SPAN - 1;
+    }
+
+    while (level < WHEEL_LEVELS - 1 && delta >= (1UL << (WHEEL_BITS * (level + 1)))) {
+        level++;
+    }
+
+    uint32_t slot = (when >> (WHEEL_BITS * level)) & WHEEL_MASK;
+    uint16_t* head = &g_wheel.heads[level][slot];
+
+    e->level = (uint8_t)level;
+    e->slot = (uint8_t)slot;
+    e->state = ENTRY_PENDING;
+    e->prev = ENTRY_NIL;
+    e->next = *head;
+    if (*head != ENTRY_NIL) {
+        g_wheel.entries[*head].prev = index;
+    }
+    *head = index;
+
+    g_wheel.pending++;
+}
+
+/**
+ * @brief Unlink an entry from its slot (critical section held)
+ */
+static void wheel_remove(uint16_t index)
+{
+    cf_threadpool_timer_entry_t* e = &g_wheel.entries[index];
+
+    if (e->prev != ENTRY_NIL) {
+        g_wheel.entries[e->prev].next = e->next;
+    } else {
+        g_wheel.heads[e->level][e->slot] = e->next;
+    }
+
+    if (e->next != ENTRY_NIL) {
+        g_wheel.entries[e->next].prev = e->prev;
+    }
+
+    g_wheel.pending--;
+}
+
+/**
+ * @brief Return an entry to the free list (critical section held)
+ */
+static void entry_free(uint16_t index)
+{
+    cf_threadpool_timer_entry_t* e = &g_wheel.entries[index];
+
+    e->state = ENTRY_FREE;
+    e->generation++;
+    e->next = g_wheel.free_head;
+    g_wheel.free_head = index;
+}
+
+/**
+ * @brief Re-place every job of one slot (critical section held)
+ */
+static void wheel_cascade(uint32_t level, uint32_t slot)
+{
+    uint16_t index = g_wheel.heads[level][slot];
+
+    g_wheel.heads[level][slot] = ENTRY_NIL;
+
+    while (index != ENTRY_NIL) {
+        uint16_t next = g_wheel.entries[index].next;
+        g_wheel.pending--;
+        wheel_insert(index);
+        index = next;
+    }
+}
+
+/**
+ * @brief Advance the wheel by one tick (critical section held)
+ *
+ * @return Singly linked list (via next) of expired jobs, now FIRING
+ */
+static uint16_t wheel_advance(void)
+{
+    g_wheel.now++;
+
+    uint32_t index = g_wheel.now;
+    for (uint32_t level = 1; level < WHEEL_LEVELS && (index & WHEEL_MASK) == 0; level++) {
+        index >>= WHEEL_BITS;
+        wheel_cascade(level, index & WHEEL_MASK);
+    }
+
+    uint32_t slot = g_wheel.now & WHEEL_MASK;
+    uint16_t expired = g_wheel.heads[0][slot];
+    g_wheel.heads[0][slot] = ENTRY_NIL;
+
+    for (uint16_t i = expired; i != ENTRY_NIL; i = g_wheel.entries[i].next) {
+        g_wheel.entries[i].state = ENTRY_FIRING;
+        g_wheel.pending--;
+    }
+
+    return expired;
+}
+
+/**
+ * @brief Claim the start of a stopped driver (critical section held)
+ *
+ * Wheel time stands still while the driver is stopped; expiries are
+ * relative to it, so nothing is lost.
+ *
+ * @return true if the caller must call wheel_start_driver() once out of the
+ *         critical section
+ */
+static bool wheel_claim_driver(void)
+{
+    if (g_wheel.driving) {
+        return false;
+    }
+
+    g_wheel.driving = true;
+    g_wheel.last_os_tick = (TickType_t)cf_time_get_tick_count();
+    return true;
+}
+
+/**
+ * @brief Start the driver after wheel_claim_driver() (outside the critical section)
+ *
+ * If the timer command queue is full the claim is dropped, so that the
+ * next job scheduled tries again.
+ */
+static void wheel_start_driver(void)
+{
+    if (cf_timer_start(g_wheel.driver, 0) != CF_OK) {
+        cf_critical_section_enter();
+        g_wheel.driving = false;
+        cf_critical_section_exit();
+    }
+}
+
+/**
+ * @brief Submit expired jobs and re-arm periodic ones
+ *
+ * Jobs are never run on the timer service task: a full queue is retried on
+ * the next tick whatever the pool's overload policy.
+ */
+static void wheel_dispatch(uint16_t index)
+{
+    while (index != ENTRY_NIL) {
+        cf_threadpool_timer_entry_t* e = &g_wheel.entries[index];
+        uint16_t next = e->next;
+
+        cf_threadpool_job_t job = {
+            .function = e->function,
+            .arg = e->arg,
+            .priority = e->priority,
+            .no_caller_runs = true
+        };
+
+        cf_status_t status = cf_threadpool_submit_job(e->pool, &job, 0);
+
+        // A full queue is retried on the next tick; other errors drop the run
+        bool retry = (status == CF_ERROR_QUEUE_FULL);
+
+        cf_critical_section_enter();
+        if (e->cancelled || (!retry && e->period == 0)) {
+            entry_free(index);
+        } else {
+            // Periodic runs are counted from the scheduled time
+            e->expires = retry ? g_wheel.now + 1 : e->expires + e->period;
+            if ((int32_t)(e->expires - g_wheel.now) <= 0) {
+                e->expires = g_wheel.now + 1;
+            }
+            wheel_insert(index);
+        }
+        cf_critical_section_exit();
+
+        index = next;
+    }
+}
+
+/**
+ * @brief Driver timer callback (timer service task)
+ */
+static void wheel_tick(cf_timer_t timer, void* arg)
+{
+    (void)timer;
+    (void)arg;
+
+    TickType_t now = (TickType_t)cf_time_get_tick_count();
+
+    for (;;) {
+        uint16_t expired = ENTRY_NIL;
+
+        cf_critical_section_enter();
+        if ((TickType_t)(now - g_wheel.last_os_tick) < g_wheel.tick_period) {
+            cf_critical_section_exit();
+            break;
+        }
+        g_wheel.last_os_tick += g_wheel.tick_period;
+
+        if (g_wheel.pending == 0) {
+            // Empty wheel: nothing to cascade or expire
+            g_wheel.now++;
+        } else {
+            expired = wheel_advance();
+        }
+        g_wheel.dispatching = (expired != ENTRY_NIL);
+        cf_critical_section_exit();
+
+        if (expired != ENTRY_NIL) {
+            wheel_dispatch(expired);
+
+            // Wake everyone blocked in cancel_all on this dispatch
+            cf_critical_section_enter();
+            g_wheel.dispatching = false;
+            uint32_t waiters = g_wheel.dispatch_waiters;
+            g_wheel.dispatch_waiters = 0;
+            g_wheel.dispatch_generation++;
+            cf_critical_section_exit();
+
+            while (waiters-- > 0) {
+                cf_semaphore_give(g_wheel.dispatch_sem);
+            }
+        }
+    }
+
+    // Nothing left to fire: stop until a job is scheduled again
+    cf_critical_section_enter();
+    bool stop = (g_wheel.pending == 0);
+    if (stop) {
+        g_wheel.driving = false;
+    }
+    cf_critical_section_exit();
+
+    if (stop) {
+        (void)cf_timer_stop(g_wheel.driver, 0);
+
+        // A start claimed before the stop command was queued would be
+        // cancelled by it; issue it again
+        cf_critical_section_enter();
+        bool restart = g_wheel.driving;
+        cf_critical_section_exit();
+
+        if (restart) {
+            wheel_start_driver();
+        }
+    }
+}
+
+/**
+ * @brief Set up the wheel and create its driver on first use
+ */
+static cf_status_t wheel_init(void)
+{
+    bool owner = false;
+
+    for (;;) {
+        cf_critical_section_enter();
+        if (g_wheel.initialized) {
+            cf_critical_section_exit();
+            return CF_OK;
+        }
+        if (!g_wheel.initializing) {
+            g_wheel.initializing = true;
+            owner = true;
+        }
+        cf_critical_section_exit();
+
+        if (owner) {
+            break;
+        }
+
+        // Another task is creating the driver
+        cf_task_delay(1);
+    }
+
+    memset(g_wheel.heads, 0xFF, sizeof(g_wheel.heads));
+    for (uint32_t i = 0; i < CF_THREADPOOL_TIMER_SLOTS; i++) {
+        g_wheel.entries[i].next = (i + 1 < CF_THREADPOOL_TIMER_SLOTS) ? (uint16_t)(i + 1) : ENTRY_NIL;
+    }
+    g_wheel.free_head = 0;
+
+    g_wheel.tick_period = pdMS_TO_TICKS(CF_THREADPOOL_TIMER_TICK_MS);
+    if (g_wheel.tick_period == 0) {
+        g_wheel.tick_period = 1;
+    }
+
+    cf_status_t status = cf_semaphore_create(&g_wheel.dispatch_sem, UINT16_MAX, 0);
+
+    cf_timer_config_t config;
+    cf_timer_config_default(&config);
+    config.name = "tp_wheel";
+    config.period_ms = CF_THREADPOOL_TIMER_TICK_MS;
+    config.type = CF_TIMER_PERIODIC;
+    config.callback = wheel_tick;
+    config.auto_start = false;
+
+    if (status == CF_OK) {
+        status = cf_timer_create(&g_wheel.driver, &config);
+        if (status != CF_OK) {
+            cf_semaphore_destroy(g_wheel.dispatch_sem);
+        }
+    }
+
+    cf_critical_section_enter();
+    g_wheel.initialized = (status == CF_OK);
+    g_wheel.initializing = false;
+    cf_critical_section_exit();
+
+    return status;
+}
+
+/**
+ * @brief Schedule a job
+ */
+static cf_status_t schedule(cf_threadpool_t pool,
+                            cf_threadpool_task_func_t function,
+                            void* arg,
+                            cf_threadpool_priority_t priority,
+                            uint32_t delay_ms,
+                            uint32_t period_ms,
+                            cf_threadpool_timer_t* timer)
+{
+    if (timer != NULL) {
+        *timer = 0;
+    }
+
+    CF_PTR_CHECK(function);
+
+    if (pool == NULL) {
+        pool = cf_threadpool_get_default();
+        if (pool == NULL) {
+            return CF_ERROR_NOT_INITIALIZED;
+        }
+    }
+
+    cf_status_t status = wheel_init();
+    if (status != CF_OK) {
+        return status;
+    }
+
+    // Round up; the current tick is partly over, so add one
+    uint32_t delay_ticks = delay_ms / CF_THREADPOOL_TIMER_TICK_MS +
+                           ((delay_ms % CF_THREADPOOL_TIMER_TICK_MS) != 0) + 1;
+    uint32_t period_ticks = period_ms / CF_THREADPOOL_TIMER_TICK_MS +
+                            ((period_ms % CF_THREADPOOL_TIMER_TICK_MS) != 0);
+
+    cf_critical_section_enter();
+    uint16_t index = g_wheel.free_head;
+    if (index == ENTRY_NIL) {
+        cf_critical_section_exit();
+        return CF_ERROR_NO_RESOURCE;
+    }
+
+    cf_threadpool_timer_entry_t* e = &g_wheel.entries[index];
+    g_wheel.free_head = e->next;
+
+    e->pool = pool;
+    e->function = function;
+    e->arg = arg;
+    e->priority = priority;
+    e->expires = g_wheel.now + delay_ticks;
+    e->period = period_ticks;
+    e->cancelled = false;
+    wheel_insert(index);
+
+    uint16_t generation = e->generation;
+    bool start = wheel_claim_driver();
+    cf_critical_section_exit();
+
+    if (start) {
+        wheel_start_driver();
+    }
+
+    if (timer != NULL) {
+        *timer = ((uint32_t)generation << 16) | ((uint32_t)index + 1);
+    }
+
+    return CF_OK;
+}
+
+//==============================================================================
+// PUBLIC API IMPLEMENTATION
+//==============================================================================
+
+cf_status_t cf_threadpool_submit_after(cf_threadpool_task_func_t function,
+                                        void* arg,
+                                        cf_threadpool_priority_t priority,
+                                        uint32_t delay_ms,
+                                        cf_threadpool_timer_t* timer)
+{
+    return schedule(NULL, function, arg, priority, delay_ms, 0, timer);
+}
+
+cf_status_t cf_threadpool_submit_after_to(cf_threadpool_t pool,
+                                           cf_threadpool_task_func_t function,
+                                           void* arg,
+                                           cf_threadpool_priority_t priority,
+                                           uint32_t delay_ms,
+                                           cf_threadpool_timer_t* timer)
+{
+    return schedule(pool, function, arg, priority, delay_ms, 0, timer);
+}
+
+cf_status_t cf_threadpool_submit_every(cf_threadpool_task_func_t function,
+                                        void* arg,
+                                        cf_threadpool_priority_t priority,
+                                        uint32_t period_ms,
+                                        cf_threadpool_timer_t* timer)
+{
+    return cf_threadpool_submit_every_to(NULL, function, arg, priority, period_ms, timer);
+}
+
+cf_status_t cf_threadpool_submit_every_to(cf_threadpool_t pool,
+                                           cf_threadpool_task_func_t function,
+                                           void* arg,
+                                           cf_threadpool_priority_t priority,
+                                           uint32_t period_ms,
+                                           cf_threadpool_timer_t* timer)
+{
+    if (period_ms == 0) {
+        if (timer != NULL) {
+            *timer = 0;
+        }
+        return CF_ERROR_INVALID_PARAM;
+    }
+
+    // First run one period from now
+    return schedule(pool, function, arg, priority, period_ms, period_ms, timer);
+}
+
+cf_status_t cf_threadpool_timer_cancel(cf_threadpool_timer_t timer)
+{
+    uint32_t index = (timer & 0xFFFFU);
+    uint16_t generation = (uint16_t)(timer >> 16);
+    cf_status_t status = CF_ERROR_NOT_FOUND;
+
+    if (index == 0 || index > CF_THREADPOOL_TIMER_SLOTS) {
+        return CF_ERROR_NOT_FOUND;
+    }
+    index--;
+
+    cf_critical_section_enter();
+    cf_threadpool_timer_entry_t* e = &g_wheel.entries[index];
+    if (g_wheel.initialized && e->generation == generation) {
+        if (e->state == ENTRY_PENDING) {
+            wheel_remove((uint16_t)index);
+            entry_free((uint16_t)index);
+            status = CF_OK;
+        } else if (e->state == ENTRY_FIRING && !e->cancelled) {
+            // Freed by the driver once the current submission is done
+            e->cancelled = true;
+            status = CF_OK;
+        }
+    }
+    cf_critical_section_exit();
+
+    return status;
+}
+
+void cf_threadpool_timer_cancel_all(cf_threadpool_t pool)
+{
+    if (pool == NULL) {
+        pool = cf_threadpool_get_default();
+    }
+
+    if (pool == NULL || !g_wheel.initialized) {
+        return;
+    }
+
+    cf_critical_section_enter();
+    for (uint32_t i = 0; i < CF_THREADPOOL_TIMER_SLOTS; i++) {
+        cf_threadpool_timer_entry_t* e = &g_wheel.entries[i];
+        if (e->pool != pool) {
+            continue;
+        }
+        if (e->state == ENTRY_PENDING) {
+            wheel_remove((uint16_t)i);
+            entry_free((uint16_t)i);
+        } else if (e->state == ENTRY_FIRING) {
+            e->cancelled = true;
+        }
+    }
+
+    // The driver may be submitting a job it detached before the sweep
+    bool wait = g_wheel.dispatching;
+    uint32_t generation = g_wheel.dispatch_generation;
+    if (wait) {
+        g_wheel.dispatch_waiters++;
+    }
+    cf_critical_section_exit();
+
+    while (wait) {
+        (void)cf_semaphore_take(g_wheel.dispatch_sem, CF_WAIT_FOREVER);
+
+        // The token may have been meant for a waiter of an earlier dispatch;
+        // register again so that one is still given for this waiter
+        cf_critical_section_enter();
+        wait = (g_wheel.dispatch_generation == generation);
+        if (wait) {
+            g_wheel.dispatch_waiters++;
+        }
+        cf_critical_section_exit();
+    }
+}
+
+#endif /* CF_THREADPOOL_ENABLED && CF_RTOS_ENABLED */
@@ -0,0 +1,160 @@
+/**
+ * @file cf_threadpool_timer.h
+ * @brief ThreadPool delayed and periodic job submission
+ * @version 1.0.0
+ * @date 2025-11-20
+ * @author CFramework Contributors
+ *
+ * @copyright Copyright (c) 2025 CFramework
+ * Licensed under MIT License
+ *
+ * @description
+ * Delayed jobs live in a hierarchical timer wheel (4 levels of 64 slots)
+ * advanced by a single FreeRTOS software timer every
+ * CF_THREADPOOL_TIMER_TICK_MS. Scheduling and cancelling are O(1) and use
+ * entries from a static table of CF_THREADPOOL_TIMER_SLOTS; no FreeRTOS
+ * timer is created per job. The software timer runs only while jobs are
+ * pending. Expired jobs are submitted to their pool from the timer service
+ * task but never run there: if the pool queue is full the submission is
+ * retried on the next wheel tick, whatever the pool's overload policy.
+ */
+
+#ifndef CF_THREADPOOL_TIMER_H
+#define CF_THREADPOOL_TIMER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cf_common.h"
+
+#include "threadpool/cf_threadpool.h"
+
+#if CF_THREADPOOL_ENABLED && CF_RTOS_ENABLED
+
+//==============================================================================
+// TYPE DEFINITIONS
+//==============================================================================
+
+/**
+ * @brief Delayed job handle (0 = invalid)
+ *
+ * Handles are never reused while the job is pending, so cancelling a job
+ * that has already fired (one-shot) is detected.
+ */
+typedef uint32_t cf_threadpool_timer_t;
+
+//==============================================================================
+// PUBLIC API
+//==============================================================================
+
+/**
+ * @brief Submit task to the default ThreadPool after a delay
+ *
+ * @param[in] function Task function to execute
+ * @param[in] arg Argument to pass to function
+ * @param[in] priority Task priority (for queue ordering)
+ * @param[in] delay_ms Delay in milliseconds (rounded up to the wheel tick)
+ * @param[out] timer Pointer to receive handle for cancellation (may be NULL)
+ *
+ * @return CF_OK on success
+ * @return CF_ERROR_NULL_POINTER if function is NULL
+ * @return CF_ERROR_NOT_INITIALIZED if the pool is not initialized
+ * @return CF_ERROR_NO_RESOURCE if all CF_THREADPOOL_TIMER_SLOTS are in use
+ * @return CF_ERROR_NO_MEMORY if the wheel driver timer could not be created
+ *
+ * @note This function is thread-safe
+ * @note If the pool queue is full when the delay expires, the job is
+ *       retried on the next wheel tick; any other submission error drops it
+ */
+cf_status_t cf_threadpool_submit_after(cf_threadpool_task_func_t function,
+                                        void* arg,
+                                        cf_threadpool_priority_t priority,
+                                        uint32_t delay_ms,
+                                        cf_threadpool_timer_t* timer);
+
+/**
+ * @brief Submit task to a specific ThreadPool after a delay
+ *
+ * @param[in] pool Pool handle (NULL = default instance)
+ *
+ * @return See cf_threadpool_submit_after()
+ */
+cf_status_t cf_threadpool_submit_after_to(cf_threadpool_t pool,
+                                           cf_threadpool_task_func_t function,
+                                           void* arg,
+                                           cf_threadpool_priority_t priority,
+                                           uint32_t delay_ms,
+                                           cf_threadpool_timer_t* timer);
+
+/**
+ * @brief Submit task to the default ThreadPool periodically
+ *
+ * The first submission happens one period from now. Periods are counted
+ * from the scheduled time, so a late tick does not cause drift.
+ *
+ * @param[in] function Task function to execute
+ * @param[in] arg Argument to pass to function
+ * @param[in] priority Task priority (for queue ordering)
+ * @param[in] period_ms Period in milliseconds (rounded up to the wheel tick)
+ * @param[out] timer Pointer to receive handle for cancellation (may be NULL)
+ *
+ * @return CF_ERROR_INVALID_PARAM if period_ms is 0
+ * @return Otherwise see cf_threadpool_submit_after()
+ *
+ * @note This function is thread-safe
+ */
+cf_status_t cf_threadpool_submit_every(cf_threadpool_task_func_t function,
+                                        void* arg,
+                                        cf_threadpool_priority_t priority,
+                                        uint32_t period_ms,
+                                        cf_threadpool_timer_t* timer);
+
+/**
+ * @brief Submit task to a specific ThreadPool periodically
+ *
+ * @param[in] pool Pool handle (NULL = default instance)
+ *
+ * @return See cf_threadpool_submit_every()
+ */
+cf_status_t cf_threadpool_submit_every_to(cf_threadpool_t pool,
+                                           cf_threadpool_task_func_t function,
+                                           void* arg,
+                                           cf_threadpool_priority_t priority,
+                                           uint32_t period_ms,
+                                           cf_threadpool_timer_t* timer);
+
+/**
+ * @brief Cancel a delayed or periodic job
+ *
+ * @param[in] timer Handle from cf_threadpool_submit_after()/_every()
+ *
+ * @return CF_OK if the job will not be submitted (again)
+ * @return CF_ERROR_NOT_FOUND if the handle is invalid or the one-shot job
+ *         has already been submitted
+ *
+ * @note This function is thread-safe
+ * @note A job already handed to the pool is not recalled
+ */
+cf_status_t cf_threadpool_timer_cancel(cf_threadpool_timer_t timer);
+
+/**
+ * @brief Cancel every delayed and periodic job targeting a pool
+ *
+ * Called by cf_threadpool_destroy()/cf_threadpool_deinit(); returns once
+ * the timer service task no longer submits to the pool.
+ *
+ * @param[in] pool Pool handle (NULL = default instance)
+ *
+ * @note This function is thread-safe
+ * @note Must not be called from a timer callback
+ */
+void cf_threadpool_timer_cancel_all(cf_threadpool_t pool);
+
+#endif /* CF_THREADPOOL_ENABLED && CF_RTOS_ENABLED */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CF_THREADPOOL_TIMER_H */
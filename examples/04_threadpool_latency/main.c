@@ -0,0 +1,374 @@
+/**
+ * @file main.c
+ * @brief ThreadPool dispatch latency benchmark
+ *
+ * Measures the time between cf_threadpool_submit() and the moment a worker
+ * starts executing the task, while every worker is parked waiting for work.
+ * It demonstrates:
+ * - Dispatch latency per priority class (CRITICAL and LOW)
+ * - Worker wakeup behaviour of an idle pool
+ * - Reading p50/p99 from cf_threadpool_get_latency_stats()
+ *
+ * With BENCH_COMPARE_POLLING enabled, the same probe is also run against a
+ * replica of the worker loop the pool used before event-driven wakeup: one
+ * worker that tries CRITICAL, HIGH and LOW with zero timeout and otherwise
+ * blocks on the NORMAL queue for 100 ms. Both sets of numbers are printed
+ * from the same run, so the comparison does not rely on a remembered
+ * baseline.
+ *
+ * Expected results (1 kHz tick): the polling loop only sees CRITICAL and LOW
+ * work when its 100 ms NORMAL timeout expires (average around 50 ticks, max
+ * close to 100), while the pool dispatches both classes within 0-1 ticks.
+ */
+
+#include "cf.h"
+
+//==============================================================================
+// BENCHMARK CONFIGURATION
+//==============================================================================
+
+#define BENCH_ITERATIONS        50      /**< Samples per priority class */
+#define BENCH_SETTLE_MS         37      /**< Idle time between samples */
+#define BENCH_SETTLE_STRIDE_MS  13      /**< Added per sample (mod 100) so submits cover every phase of a 100 ms poll */
+
+#ifndef BENCH_COMPARE_POLLING
+#define BENCH_COMPARE_POLLING   1       /**< Also measure the pre-wakeup polling loop */
+#endif
+
+#define POLLING_QUEUE_LENGTH    4       /**< Per-class queue depth of the polling replica */
+#define POLLING_NORMAL_WAIT_MS  100     /**< NORMAL queue timeout of the old worker loop */
+
+//==============================================================================
+// BENCHMARK STATE
+//==============================================================================
+
+typedef struct {
+    volatile uint32_t submit_tick;      /**< Tick at submission */
+    volatile uint32_t start_tick;       /**< Tick when a worker picked it up */
+    volatile bool done;                 /**< Set by the task */
+} bench_sample_t;
+
+typedef struct {
+    uint32_t min;
+    uint32_t max;
+    uint32_t total;
+} bench_result_t;
+
+/**
+ * @brief Submits one task to the dispatcher under test
+ */
+typedef cf_status_t (*bench_submit_func_t)(cf_threadpool_task_func_t function,
+                                           void* arg,
+                                           cf_threadpool_priority_t priority);
+
+//==============================================================================
+// TASK DEFINITIONS
+//==============================================================================
+
+/**
+ * @brief Records the tick at which a worker started executing it
+ */
+static void latency_probe_task(void* arg)
+{
+    bench_sample_t* sample = (bench_sample_t*)arg;
+
+    sample->start_tick = cf_time_get_tick_count();
+    sample->done = true;
+}
+
+//==============================================================================
+// DISPATCHERS UNDER TEST
+//==============================================================================
+
+/**
+ * @brief Submit to the default thread pool (event-driven wakeup)
+ */
+static cf_status_t pool_submit(cf_threadpool_task_func_t function,
+                               void* arg,
+                               cf_threadpool_priority_t priority)
+{
+    return cf_threadpool_submit(function, arg, priority, CF_WAIT_FOREVER);
+}
+
+#if BENCH_COMPARE_POLLING
+
+typedef struct {
+    cf_threadpool_task_func_t function;
+    void* arg;
+} polling_item_t;
+
+static cf_queue_t g_polling_queues[CF_THREADPOOL_PRIORITY_COUNT];
+static cf_task_t g_polling_task;
+static volatile bool g_polling_running;
+static volatile bool g_polling_stopped;
+
+/**
+ * @brief Replica of the worker loop before event-driven wakeup
+ *
+ * Higher classes are only checked with zero timeout; the worker otherwise
+ * sleeps in the NORMAL queue, so CRITICAL and LOW work submitted meanwhile
+ * waits for that timeout to expire.
+ */
+static void polling_worker(void* arg)
+{
+    polling_item_t item;
+
+    (void)arg;
+
+    while (g_polling_running) {
+        if (cf_queue_receive(g_polling_queues[CF_THREADPOOL_PRIORITY_CRITICAL], &item, 0) == CF_OK ||
+            cf_queue_receive(g_polling_queues[CF_THREADPOOL_PRIORITY_HIGH], &item, 0) == CF_OK ||
+            cf_queue_receive(g_polling_queues[CF_THREADPOOL_PRIORITY_NORMAL], &item,
+                             POLLING_NORMAL_WAIT_MS) == CF_OK ||
+            cf_queue_receive(g_polling_queues[CF_THREADPOOL_PRIORITY_LOW], &item, 0) == CF_OK) {
+            item.function(item.arg);
+        }
+    }
+
+    g_polling_stopped = true;
+    while (1) {
+        cf_task_delay(1000);
+    }
+}
+
+/**
+ * @brief Submit to the polling replica
+ */
+static cf_status_t polling_submit(cf_threadpool_task_func_t function,
+                                  void* arg,
+                                  cf_threadpool_priority_t priority)
+{
+    polling_item_t item = { .function = function, .arg = arg };
+
+    return cf_queue_send(g_polling_queues[priority], &item, CF_WAIT_FOREVER);
+}
+
+/**
+ * @brief Create the polling replica's queues and worker
+ */
+static cf_status_t polling_start(void)
+{
+    for (uint32_t i = 0; i < CF_THREADPOOL_PRIORITY_COUNT; i++) {
+        cf_status_t status = cf_queue_create(&g_polling_queues[i], POLLING_QUEUE_LENGTH,
+                                             sizeof(polling_item_t));
+        if (status != CF_OK) {
+            return status;
+        }
+    }
+
+    cf_task_config_t task_config;
+    cf_task_config_default(&task_config);
+    task_config.name = "PollWorker";
+    task_config.function = polling_worker;
+    task_config.stack_size = 2048;
+    task_config.priority = CF_TASK_PRIORITY_NORMAL;
+
+    g_polling_running = true;
+    g_polling_stopped = false;
+    return cf_task_create(&g_polling_task, &task_config);
+}
+
+/**
+ * @brief Stop the polling replica and release its resources
+ */
+static void polling_stop(void)
+{
+    g_polling_running = false;
+    while (!g_polling_stopped) {
+        cf_task_delay(10);
+    }
+
+    cf_task_delete(g_polling_task);
+    for (uint32_t i = 0; i < CF_THREADPOOL_PRIORITY_COUNT; i++) {
+        cf_queue_destroy(g_polling_queues[i]);
+    }
+}
+
+#endif /* BENCH_COMPARE_POLLING */
+
+//==============================================================================
+// BENCHMARK
+//==============================================================================
+
+/**
+ * @brief Measure dispatch latency for one priority class
+ */
+static void bench_priority(bench_submit_func_t submit,
+                           cf_threadpool_priority_t priority,
+                           const char* name,
+                           bench_result_t* result)
+{
+    bench_sample_t sample;
+
+    result->min = UINT32_MAX;
+    result->max = 0;
+    result->total = 0;
+
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+        // Let every worker park on its wait primitive
+        cf_task_delay(BENCH_SETTLE_MS + (i * BENCH_SETTLE_STRIDE_MS) % 100);
+
+        sample.done = false;
+        sample.submit_tick = cf_time_get_tick_count();
+
+        if (submit(latency_probe_task, &sample, priority) != CF_OK) {
+            CF_LOG_E("%s: submit failed", name);
+            return;
+        }
+
+        while (!sample.done) {
+            cf_task_delay(1);
+        }
+
+        uint32_t latency = sample.start_tick - sample.submit_tick;
+        result->min = CF_MIN(result->min, latency);
+        result->max = CF_MAX(result->max, latency);
+        result->total += latency;
+    }
+
+    CF_LOG_I("%-8s dispatch latency: min %lu, avg %lu, max %lu ticks (%lu samples)",
+             name, result->min, result->total / BENCH_ITERATIONS, result->max,
+             (uint32_t)BENCH_ITERATIONS);
+}
+
+//==============================================================================
+// MAIN APPLICATION TASK
+//==============================================================================
+
+/**
+ * @brief Main application task
+ */
+void app_main_task(void* arg)
+{
+    bench_result_t critical;
+    bench_result_t low;
+#if BENCH_COMPARE_POLLING
+    bench_result_t polling_critical;
+    bench_result_t polling_low;
+#endif
+
+    CF_LOG_I("=== CFramework ThreadPool Latency Benchmark ===");
+    CF_LOG_I("Framework Version: %s", CF_VERSION_STRING);
+
+    cf_status_t status = cf_threadpool_init();
+    if (status != CF_OK) {
+        CF_LOG_E("ThreadPool init failed: %d", status);
+        return;
+    }
+
+    // Give workers time to start and block
+    cf_task_delay(500);
+
+#if BENCH_COMPARE_POLLING
+    // Baseline: the pre-wakeup worker loop, measured in this same run
+    status = polling_start();
+    if (status != CF_OK) {
+        CF_LOG_E("Polling replica start failed: %d", status);
+        return;
+    }
+    cf_task_delay(500);
+
+    CF_LOG_I("--- Polling worker loop (%lu ms NORMAL timeout) ---",
+             (uint32_t)POLLING_NORMAL_WAIT_MS);
+    bench_priority(polling_submit, CF_THREADPOOL_PRIORITY_CRITICAL, "CRITICAL", &polling_critical);
+    bench_priority(polling_submit, CF_THREADPOOL_PRIORITY_LOW, "LOW", &polling_low);
+    polling_stop();
+
+    CF_LOG_I("--- Thread pool (event-driven wakeup) ---");
+#endif
+
+    bench_priority(pool_submit, CF_THREADPOOL_PRIORITY_CRITICAL, "CRITICAL", &critical);
+    bench_priority(pool_submit, CF_THREADPOOL_PRIORITY_LOW, "LOW", &low);
+
+#if BENCH_COMPARE_POLLING
+    CF_LOG_I("Average CRITICAL: %lu -> %lu ticks, LOW: %lu -> %lu ticks (polling -> pool)",
+             polling_critical.total / BENCH_ITERATIONS, critical.total / BENCH_ITERATIONS,
+             polling_low.total / BENCH_ITERATIONS, low.total / BENCH_ITERATIONS);
+#endif
+
+    // Same measurement as seen by the pool (cycle-counter resolution)
+    cf_threadpool_latency_stats_t latency;
+    if (cf_threadpool_get_latency_stats(NULL, &latency) == CF_OK) {
+        const cf_threadpool_class_latency_t* cls;
+
+        cls = &latency.classes[CF_THREADPOOL_PRIORITY_CRITICAL];
+        CF_LOG_I("CRITICAL queue wait: p50 <= %lu us, p99 <= %lu us, max %lu us",
+                 cf_threadpool_latency_percentile(cls->wait_hist, 50),
+                 cf_threadpool_latency_percentile(cls->wait_hist, 99),
+                 cls->wait_max_us);
+
+        cls = &latency.classes[CF_THREADPOOL_PRIORITY_LOW];
+        CF_LOG_I("LOW      queue wait: p50 <= %lu us, p99 <= %lu us, max %lu us",
+                 cf_threadpool_latency_percentile(cls->wait_hist, 50),
+                 cf_threadpool_latency_percentile(cls->wait_hist, 99),
+                 cls->wait_max_us);
+    }
+
+    cf_threadpool_deinit(true);
+
+    CF_LOG_I("=== Benchmark completed ===");
+
+    while (1) {
+        cf_task_delay(1000);
+    }
+}
+
+//==============================================================================
+// UART CONFIGURATION
+//==============================================================================
+
+#if defined(CF_PLATFORM_STM32L4) || defined(CF_PLATFORM_STM32L1)
+    extern UART_HandleTypeDef huart2;
+    #define LOG_UART_HANDLE &huart2
+#elif defined(CF_PLATFORM_ESP32)
+    #define LOG_UART_PORT UART_NUM_0
+#endif
+
+//==============================================================================
+// MAIN ENTRY POINT
+//==============================================================================
+
+int main(void)
+{
+    // Hardware initialization (platform-specific)
+#if defined(CF_PLATFORM_STM32L4) || defined(CF_PLATFORM_STM32L1)
+    HAL_Init();
+    SystemClock_Config();  // Implement this
+#endif
+
+    // Initialize logger
+    cf_log_init();
+
+#if defined(CF_PLATFORM_STM32L4) || defined(CF_PLATFORM_STM32L1)
+    cf_log_uart_sink_t uart_sink;
+    cf_log_uart_sink_init(&uart_sink, LOG_UART_HANDLE, CF_LOG_DEBUG);
+    cf_log_add_sink(&uart_sink.base);
+#elif defined(CF_PLATFORM_ESP32)
+    cf_log_uart_sink_t uart_sink;
+    cf_log_uart_sink_init(&uart_sink, LOG_UART_PORT, CF_LOG_DEBUG);
+    cf_log_add_sink(&uart_sink.base);
+#endif
+
+    CF_LOG_I("System starting...");
+
+    // Create main application task (above worker priority so it can measure)
+    cf_task_config_t task_config;
+    cf_task_config_default(&task_config);
+    task_config.name = "AppMain";
+    task_config.function = app_main_task;
+    task_config.stack_size = 4096;
+    task_config.priority = CF_TASK_PRIORITY_ABOVE_NORMAL;
+
+    cf_task_t app_task;
+    cf_status_t status = cf_task_create(&app_task, &task_config);
+    if (status != CF_OK) {
+        CF_LOG_E("Failed to create app task: %d", status);
+        while (1);
+    }
+
+    // Start FreeRTOS scheduler
+    CF_LOG_I("Starting RTOS scheduler...");
+    cf_task_start_scheduler();
+
+    return 0;
+}